@@ -0,0 +1,583 @@
+#include "microbench.hpp"
+#include "strong_flags/strong_flags.hpp"
+#include "strong_flags/atomic.hpp"
+#include "strong_flags/bulk.hpp"
+#include "strong_flags/sharded.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Every operation is measured twice: through the strong_flags type and as the equivalent
+// hand-written operation on the raw word(s). Full-width types are used so masking is a no-op
+// and both variants compute exactly the same thing.
+
+namespace {
+
+template<typename Integer>
+class full_flags : public strong_flags::impl<full_flags<Integer>, Integer, sizeof(Integer) * 8> {
+private:
+    using base_type = strong_flags::impl<full_flags<Integer>, Integer, sizeof(Integer) * 8>;
+
+public:
+    using base_type::base_type;
+};
+
+class wide_flags : public strong_flags::impl<wide_flags, strong_flags::wide_bitset<256>, 256> {
+private:
+    using base_type = strong_flags::impl<wide_flags, strong_flags::wide_bitset<256>, 256>;
+
+public:
+    using base_type::base_type;
+};
+
+constexpr std::size_t s_set_size = 1024;
+constexpr std::size_t s_batch_size = 1 << 20;
+
+// One cached input set per element type and size, so every benchmark sees exactly `Count` values.
+template<typename Integer, std::size_t Count>
+const std::vector<Integer>& raw_inputs() {
+    static const std::vector<Integer> s_values = [] {
+        std::mt19937_64 engine { 42 };
+        std::vector<Integer> values(Count);
+        for (auto& value : values) {
+            value = static_cast<Integer>(engine() & engine());
+        }
+        return values;
+    }();
+    return s_values;
+}
+
+template<typename FlagType, std::size_t Count>
+const std::vector<FlagType>& flag_inputs() {
+    static const std::vector<FlagType> s_values = [] {
+        using underlying_type = typename FlagType::underlying_type;
+        const auto& raw = raw_inputs<underlying_type, Count>();
+        std::vector<FlagType> values;
+        values.reserve(raw.size());
+        for (auto value : raw) {
+            values.push_back(FlagType::from_underlying_type(value));
+        }
+        return values;
+    }();
+    return s_values;
+}
+
+enum class op {
+    bit_or, bit_and, bit_xor, bit_not, test, test_any, test_all, set_bit, clear_bit, toggle_bit, count, lowest_bit
+};
+
+template<typename Integer, op O>
+Integer raw_step(Integer acc, Integer value, std::size_t bit) {
+    constexpr Integer one = 1;
+    if constexpr (O == op::bit_or) {
+        return static_cast<Integer>(acc | value);
+    } else if constexpr (O == op::bit_and) {
+        return static_cast<Integer>((acc & value) ^ value);
+    } else if constexpr (O == op::bit_xor) {
+        return static_cast<Integer>(acc ^ value);
+    } else if constexpr (O == op::bit_not) {
+        return static_cast<Integer>(~(acc ^ value));
+    } else if constexpr (O == op::test) {
+        return static_cast<Integer>(acc + (((one << bit) & value) != 0));
+    } else if constexpr (O == op::test_any) {
+        return static_cast<Integer>(acc + ((acc & value) != 0));
+    } else if constexpr (O == op::test_all) {
+        return static_cast<Integer>(acc + ((acc & value) == value));
+    } else if constexpr (O == op::set_bit) {
+        return static_cast<Integer>((acc ^ value) | (one << bit));
+    } else if constexpr (O == op::clear_bit) {
+        return static_cast<Integer>((acc ^ value) & ~(one << bit));
+    } else if constexpr (O == op::toggle_bit) {
+        return static_cast<Integer>((acc ^ value) ^ (one << bit));
+    } else if constexpr (O == op::count) {
+        return static_cast<Integer>(acc + strong_flags::detail::popcount(value));
+    } else {
+        return static_cast<Integer>(acc + (value == 0 ? sizeof(Integer) * 8
+                : static_cast<std::size_t>(strong_flags::detail::countr_zero(value))));
+    }
+}
+
+template<typename FlagType, op O>
+FlagType strong_step(FlagType acc, FlagType value, std::size_t bit) {
+    using underlying_type = typename FlagType::underlying_type;
+    if constexpr (O == op::bit_or) {
+        return acc | value;
+    } else if constexpr (O == op::bit_and) {
+        return (acc & value) ^ value;
+    } else if constexpr (O == op::bit_xor) {
+        return acc ^ value;
+    } else if constexpr (O == op::bit_not) {
+        return ~(acc ^ value);
+    } else if constexpr (O == op::test) {
+        return FlagType::from_underlying_type(
+                static_cast<underlying_type>(acc.to_underlying_type() + value.test(bit)));
+    } else if constexpr (O == op::test_any) {
+        return FlagType::from_underlying_type(
+                static_cast<underlying_type>(acc.to_underlying_type() + acc.test_any(value)));
+    } else if constexpr (O == op::test_all) {
+        return FlagType::from_underlying_type(
+                static_cast<underlying_type>(acc.to_underlying_type() + acc.test_all(value)));
+    } else if constexpr (O == op::set_bit) {
+        return (acc ^ value).set(bit);
+    } else if constexpr (O == op::clear_bit) {
+        return (acc ^ value).clear(bit);
+    } else if constexpr (O == op::toggle_bit) {
+        return (acc ^ value).toggle(bit);
+    } else if constexpr (O == op::count) {
+        return FlagType::from_underlying_type(
+                static_cast<underlying_type>(acc.to_underlying_type() + value.count()));
+    } else {
+        return FlagType::from_underlying_type(
+                static_cast<underlying_type>(acc.to_underlying_type() + value.lowest_bit()));
+    }
+}
+
+template<typename Integer, op O>
+void single_raw(std::size_t iterations) {
+    const auto& values = raw_inputs<Integer, s_set_size>();
+    Integer acc = 0;
+    for (std::size_t it = 0; it < iterations; ++it) {
+        for (std::size_t i = 0; i < s_set_size; ++i) {
+            acc = raw_step<Integer, O>(acc, values[i], i % (sizeof(Integer) * 8));
+        }
+        microbench::do_not_optimize(acc);
+    }
+}
+
+template<typename Integer, op O>
+void single_strong(std::size_t iterations) {
+    using flag_type = full_flags<Integer>;
+    const auto& values = flag_inputs<flag_type, s_set_size>();
+    flag_type acc;
+    for (std::size_t it = 0; it < iterations; ++it) {
+        for (std::size_t i = 0; i < s_set_size; ++i) {
+            acc = strong_step<flag_type, O>(acc, values[i], i % (sizeof(Integer) * 8));
+        }
+        microbench::do_not_optimize(acc);
+    }
+}
+
+constexpr const char* op_name(op o) {
+    constexpr const char* names[] = { "or", "and", "xor", "not", "test", "test_any", "test_all", "set_bit",
+            "clear_bit", "toggle_bit", "count", "lowest_bit" };
+    return names[static_cast<int>(o)];
+}
+
+std::deque<std::string>& name_storage() {
+    static std::deque<std::string> s_names;
+    return s_names;
+}
+
+const char* make_name(const char* type, const char* what, const char* variant) {
+    auto& names = name_storage();
+    names.push_back(std::string(type) + "/" + what + "/" + variant);
+    return names.back().c_str();
+}
+
+template<typename Integer, op O>
+void register_single_op(const char* type) {
+    microbench::registry::instance().add("single", make_name(type, op_name(O), "raw"), &single_raw<Integer, O>,
+            s_set_size);
+    microbench::registry::instance().add("single", make_name(type, op_name(O), "strong"),
+            &single_strong<Integer, O>, s_set_size);
+}
+
+template<typename Integer>
+void register_single(const char* type) {
+    register_single_op<Integer, op::bit_or>(type);
+    register_single_op<Integer, op::bit_and>(type);
+    register_single_op<Integer, op::bit_xor>(type);
+    register_single_op<Integer, op::bit_not>(type);
+    register_single_op<Integer, op::test>(type);
+    register_single_op<Integer, op::test_any>(type);
+    register_single_op<Integer, op::test_all>(type);
+    register_single_op<Integer, op::set_bit>(type);
+    register_single_op<Integer, op::clear_bit>(type);
+    register_single_op<Integer, op::toggle_bit>(type);
+    register_single_op<Integer, op::count>(type);
+    register_single_op<Integer, op::lowest_bit>(type);
+}
+
+// Wide flags against a hand-written loop over four 64 bit words.
+
+const std::vector<wide_flags>& wide_inputs() {
+    static const std::vector<wide_flags> s_values = [] {
+        const auto& raw = raw_inputs<std::uint64_t, s_set_size * 4>();
+        std::vector<wide_flags> values(s_set_size);
+        for (std::size_t i = 0; i < s_set_size; ++i) {
+            strong_flags::wide_bitset<256> bits;
+            for (std::size_t w = 0; w < 4; ++w) {
+                bits.word(w) = raw[i * 4 + w];
+            }
+            values[i] = wide_flags::from_underlying_type(bits);
+        }
+        return values;
+    }();
+    return s_values;
+}
+
+template<op O>
+void wide_raw(std::size_t iterations) {
+    const auto& raw = raw_inputs<std::uint64_t, s_set_size * 4>();
+    alignas(32) std::uint64_t acc[4] = { };
+    std::size_t hits = 0;
+    for (std::size_t it = 0; it < iterations; ++it) {
+        for (std::size_t i = 0; i < s_set_size; ++i) {
+            const std::uint64_t* value = &raw[i * 4];
+            if constexpr (O == op::bit_or) {
+                for (std::size_t w = 0; w < 4; ++w) {
+                    acc[w] |= value[w];
+                }
+            } else if constexpr (O == op::bit_xor) {
+                for (std::size_t w = 0; w < 4; ++w) {
+                    acc[w] ^= value[w];
+                }
+            } else if constexpr (O == op::bit_not) {
+                for (std::size_t w = 0; w < 4; ++w) {
+                    acc[w] = ~(acc[w] ^ value[w]);
+                }
+            } else if constexpr (O == op::test_any) {
+                std::uint64_t any = 0;
+                for (std::size_t w = 0; w < 4; ++w) {
+                    any |= acc[w] & value[w];
+                }
+                hits += any != 0;
+                acc[i % 4] ^= value[i % 4];
+            } else if constexpr (O == op::test_all) {
+                bool all = true;
+                for (std::size_t w = 0; w < 4; ++w) {
+                    all &= (acc[w] & value[w]) == value[w];
+                }
+                hits += all;
+                acc[i % 4] ^= value[i % 4];
+            } else {
+                for (std::size_t w = 0; w < 4; ++w) {
+                    hits += static_cast<std::size_t>(strong_flags::detail::popcount(value[w]));
+                }
+            }
+        }
+        microbench::do_not_optimize(acc);
+        microbench::do_not_optimize(hits);
+    }
+}
+
+template<op O>
+void wide_strong(std::size_t iterations) {
+    const auto& values = wide_inputs();
+    wide_flags acc;
+    std::size_t hits = 0;
+    for (std::size_t it = 0; it < iterations; ++it) {
+        for (std::size_t i = 0; i < s_set_size; ++i) {
+            const auto& value = values[i];
+            if constexpr (O == op::bit_or) {
+                acc |= value;
+            } else if constexpr (O == op::bit_xor) {
+                acc ^= value;
+            } else if constexpr (O == op::bit_not) {
+                acc = ~(acc ^ value);
+            } else if constexpr (O == op::test_any) {
+                hits += acc.test_any(value);
+                acc ^= value;
+            } else if constexpr (O == op::test_all) {
+                hits += acc.test_all(value);
+                acc ^= value;
+            } else {
+                hits += value.count();
+            }
+        }
+        microbench::do_not_optimize(acc);
+        microbench::do_not_optimize(hits);
+    }
+}
+
+template<op O>
+void register_wide_op() {
+    microbench::registry::instance().add("single", make_name("wide256", op_name(O), "raw"), &wide_raw<O>, s_set_size);
+    microbench::registry::instance().add("single", make_name("wide256", op_name(O), "strong"), &wide_strong<O>,
+            s_set_size);
+}
+
+// Batch: element-wise loops written against both APIs, and the bulk kernels.
+
+template<typename Integer>
+void batch_count_raw(std::size_t iterations) {
+    const auto& values = raw_inputs<Integer, s_batch_size>();
+    const auto mask = static_cast<Integer>(0x5);
+    for (std::size_t it = 0; it < iterations; ++it) {
+        std::size_t hits = 0;
+        for (auto value : values) {
+            hits += (value & mask) != 0;
+        }
+        microbench::do_not_optimize(hits);
+    }
+}
+
+template<typename Integer>
+void batch_count_strong(std::size_t iterations) {
+    using flag_type = full_flags<Integer>;
+    const auto& values = flag_inputs<flag_type, s_batch_size>();
+    const auto mask = flag_type::from_underlying_type(0x5);
+    for (std::size_t it = 0; it < iterations; ++it) {
+        std::size_t hits = 0;
+        for (const auto& value : values) {
+            hits += value.test_any(mask);
+        }
+        microbench::do_not_optimize(hits);
+    }
+}
+
+template<typename Integer>
+void batch_count_bulk(std::size_t iterations) {
+    using flag_type = full_flags<Integer>;
+    const auto& values = flag_inputs<flag_type, s_batch_size>();
+    const auto mask = flag_type::from_underlying_type(0x5);
+    for (std::size_t it = 0; it < iterations; ++it) {
+        auto hits = strong_flags::bulk::count_any(values.data(), values.size(), mask);
+        microbench::do_not_optimize(hits);
+    }
+}
+
+template<typename Integer>
+void batch_toggle_raw(std::size_t iterations) {
+    auto values = raw_inputs<Integer, s_batch_size>();
+    const auto mask = static_cast<Integer>(0x5);
+    for (std::size_t it = 0; it < iterations; ++it) {
+        for (auto& value : values) {
+            value = static_cast<Integer>(value ^ mask);
+        }
+        microbench::clobber_memory();
+    }
+}
+
+template<typename Integer>
+void batch_toggle_strong(std::size_t iterations) {
+    using flag_type = full_flags<Integer>;
+    auto values = flag_inputs<flag_type, s_batch_size>();
+    const auto mask = flag_type::from_underlying_type(0x5);
+    for (std::size_t it = 0; it < iterations; ++it) {
+        for (auto& value : values) {
+            value.toggle(mask);
+        }
+        microbench::clobber_memory();
+    }
+}
+
+template<typename Integer>
+void batch_toggle_bulk(std::size_t iterations) {
+    using flag_type = full_flags<Integer>;
+    auto values = flag_inputs<flag_type, s_batch_size>();
+    const auto mask = flag_type::from_underlying_type(0x5);
+    for (std::size_t it = 0; it < iterations; ++it) {
+        strong_flags::bulk::toggle(values.data(), values.size(), mask);
+        microbench::clobber_memory();
+    }
+}
+
+template<typename Integer>
+void register_batch(const char* type) {
+    auto& registry = microbench::registry::instance();
+    registry.add("batch", make_name(type, "count_any", "raw"), &batch_count_raw<Integer>, s_batch_size);
+    registry.add("batch", make_name(type, "count_any", "strong"), &batch_count_strong<Integer>, s_batch_size);
+    registry.add("batch", make_name(type, "count_any", "bulk"), &batch_count_bulk<Integer>, s_batch_size);
+    registry.add("batch", make_name(type, "toggle", "raw"), &batch_toggle_raw<Integer>, s_batch_size);
+    registry.add("batch", make_name(type, "toggle", "strong"), &batch_toggle_strong<Integer>, s_batch_size);
+    registry.add("batch", make_name(type, "toggle", "bulk"), &batch_toggle_bulk<Integer>, s_batch_size);
+}
+
+// Multi-threaded: contended read-modify-write on one shared word, and chunked scans.
+
+std::size_t thread_count() {
+    return std::max<std::size_t>(2, std::thread::hardware_concurrency());
+}
+
+template<typename Function>
+void run_threads(Function function) {
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < thread_count(); ++t) {
+        threads.emplace_back([&function, t] {
+            function(t);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+constexpr std::size_t s_atomic_ops = 1 << 14;
+
+void threaded_atomic_raw(std::size_t iterations) {
+    std::atomic<std::uint32_t> word { 0 };
+    for (std::size_t it = 0; it < iterations; ++it) {
+        run_threads([&word](std::size_t t) {
+            for (std::size_t i = 0; i < s_atomic_ops; ++i) {
+                word.fetch_or(1U << ((t + i) % 32), std::memory_order_relaxed);
+                word.fetch_and(~(1U << ((t + i) % 32)), std::memory_order_relaxed);
+            }
+        });
+    }
+}
+
+void threaded_atomic_strong(std::size_t iterations) {
+    strong_flags::atomic<full_flags<std::uint32_t>> word;
+    for (std::size_t it = 0; it < iterations; ++it) {
+        run_threads([&word](std::size_t t) {
+            for (std::size_t i = 0; i < s_atomic_ops; ++i) {
+                word.fetch_set((t + i) % 32, std::memory_order_relaxed);
+                word.fetch_clear((t + i) % 32, std::memory_order_relaxed);
+            }
+        });
+    }
+}
+
+void threaded_count_raw(std::size_t iterations) {
+    const auto& values = raw_inputs<std::uint32_t, s_batch_size>();
+    for (std::size_t it = 0; it < iterations; ++it) {
+        std::vector<std::size_t> hits(thread_count());
+        run_threads([&values, &hits](std::size_t t) {
+            const std::size_t chunk = (values.size() + thread_count() - 1) / thread_count();
+            const std::size_t end = std::min(values.size(), (t + 1) * chunk);
+            std::size_t local = 0;
+            for (std::size_t i = t * chunk; i < end; ++i) {
+                local += (values[i] & 0x5U) != 0;
+            }
+            hits[t] = local;
+        });
+        microbench::do_not_optimize(hits);
+    }
+}
+
+void threaded_count_bulk(std::size_t iterations) {
+    using flag_type = full_flags<std::uint32_t>;
+    const auto& values = flag_inputs<flag_type, s_batch_size>();
+    const strong_flags::bulk::parallel policy { thread_count(), 1024 };
+    for (std::size_t it = 0; it < iterations; ++it) {
+        auto hits = strong_flags::bulk::count_any(policy, values.data(), values.size(),
+                flag_type::from_underlying_type(0x5U));
+        microbench::do_not_optimize(hits);
+    }
+}
+
+// Sticky flags raised from a growing number of threads: one shared atomic word against per-thread shards.
+// sharded_flags skips the atomic when the bit is already set, so the shared word is also measured with that
+// check, to separate the gain of sharding from the gain of not writing. Every round ends with a drain, as a
+// monitoring thread would do.
+
+template<std::size_t Threads, typename Function>
+void run_fixed_threads(Function function) {
+    std::vector<std::thread> threads;
+    for (std::size_t t = 1; t < Threads; ++t) {
+        threads.emplace_back([&function, t] {
+            function(t);
+        });
+    }
+    function(std::size_t { 0 });
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+template<std::size_t Threads>
+void sticky_atomic_raw(std::size_t iterations) {
+    std::atomic<std::uint32_t> word { 0 };
+    for (std::size_t it = 0; it < iterations; ++it) {
+        run_fixed_threads<Threads>([&word](std::size_t t) {
+            for (std::size_t i = 0; i < s_atomic_ops; ++i) {
+                word.fetch_or(1U << ((t + i) % 32), std::memory_order_relaxed);
+            }
+        });
+        auto collected = word.exchange(0);
+        microbench::do_not_optimize(collected);
+    }
+}
+
+template<std::size_t Threads>
+void sticky_atomic_checked(std::size_t iterations) {
+    std::atomic<std::uint32_t> word { 0 };
+    for (std::size_t it = 0; it < iterations; ++it) {
+        run_fixed_threads<Threads>([&word](std::size_t t) {
+            for (std::size_t i = 0; i < s_atomic_ops; ++i) {
+                const std::uint32_t bit = 1U << ((t + i) % 32);
+                if ((word.load(std::memory_order_relaxed) & bit) == 0) {
+                    word.fetch_or(bit, std::memory_order_relaxed);
+                }
+            }
+        });
+        auto collected = word.exchange(0);
+        microbench::do_not_optimize(collected);
+    }
+}
+
+template<std::size_t Threads>
+void sticky_sharded(std::size_t iterations) {
+    strong_flags::sharded_flags<full_flags<std::uint32_t>> flags;
+    for (std::size_t it = 0; it < iterations; ++it) {
+        run_fixed_threads<Threads>([&flags](std::size_t t) {
+            for (std::size_t i = 0; i < s_atomic_ops; ++i) {
+                flags.set((t + i) % 32, std::memory_order_relaxed);
+            }
+        });
+        auto collected = flags.clear_and_collect();
+        microbench::do_not_optimize(collected);
+    }
+}
+
+template<std::size_t Threads>
+void register_sticky() {
+    if (Threads > thread_count()) {
+        return;
+    }
+    const std::string threads = "t" + std::to_string(Threads);
+    auto& registry = microbench::registry::instance();
+    registry.add("sticky", make_name("u32", threads.c_str(), "atomic"), &sticky_atomic_raw<Threads>,
+            s_atomic_ops * Threads);
+    registry.add("sticky", make_name("u32", threads.c_str(), "atomic_checked"), &sticky_atomic_checked<Threads>,
+            s_atomic_ops * Threads);
+    registry.add("sticky", make_name("u32", threads.c_str(), "sharded"), &sticky_sharded<Threads>,
+            s_atomic_ops * Threads);
+}
+
+void register_all() {
+    register_single<std::uint8_t>("u8");
+    register_single<std::uint16_t>("u16");
+    register_single<std::uint32_t>("u32");
+    register_single<std::uint64_t>("u64");
+
+    register_wide_op<op::bit_or>();
+    register_wide_op<op::bit_xor>();
+    register_wide_op<op::bit_not>();
+    register_wide_op<op::test_any>();
+    register_wide_op<op::test_all>();
+    register_wide_op<op::count>();
+
+    register_batch<std::uint8_t>("u8");
+    register_batch<std::uint16_t>("u16");
+    register_batch<std::uint32_t>("u32");
+    register_batch<std::uint64_t>("u64");
+
+    auto& registry = microbench::registry::instance();
+    registry.add("threaded", "u32/fetch_set_clear/raw", &threaded_atomic_raw, s_atomic_ops * 2);
+    registry.add("threaded", "u32/fetch_set_clear/strong", &threaded_atomic_strong, s_atomic_ops * 2);
+    registry.add("threaded", "u32/count_any/raw", &threaded_count_raw, s_batch_size);
+    registry.add("threaded", "u32/count_any/bulk", &threaded_count_bulk, s_batch_size);
+
+    register_sticky<1>();
+    register_sticky<2>();
+    register_sticky<4>();
+    register_sticky<8>();
+    register_sticky<16>();
+    register_sticky<32>();
+    register_sticky<64>();
+    register_sticky<128>();
+}
+
+}
+
+int main(int argc, char** argv) {
+    register_all();
+    return microbench::registry::instance().run(argc > 1 ? argv[1] : nullptr);
+}
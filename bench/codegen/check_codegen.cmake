@@ -0,0 +1,75 @@
+# Compiles codegen_ops.cpp to assembly and checks that every sf_<name> function has exactly the
+# same instruction sequence as raw_<name>. Instructions are compared by mnemonic: the compiler is free
+# to pick different registers or swap the operands of commutative operations.
+#
+# Expected variables: COMPILER, COMPILER_ID, SOURCE, INCLUDE_DIR, OUTPUT, FLAGS (optional, ;-list)
+
+set(compile_flags -std=c++17 -O2 -S -fno-asynchronous-unwind-tables -fno-exceptions -fno-stack-protector)
+if (COMPILER_ID STREQUAL "GNU")
+	# Identical code folding would turn one function of a pair into an alias of the other.
+	list(APPEND compile_flags -fno-ipa-icf)
+endif()
+
+execute_process(
+	COMMAND ${COMPILER} ${compile_flags} ${FLAGS} -I${INCLUDE_DIR} -o ${OUTPUT} ${SOURCE}
+	RESULT_VARIABLE compile_result
+	ERROR_VARIABLE compile_error)
+if (NOT compile_result EQUAL 0)
+	message(FATAL_ERROR "Compiling ${SOURCE} failed:\n${compile_error}")
+endif()
+
+file(STRINGS ${OUTPUT} lines)
+
+set(current "")
+set(functions "")
+foreach(line IN LISTS lines)
+	if (line MATCHES "^((sf|raw)_[A-Za-z0-9_]+):")
+		set(current ${CMAKE_MATCH_1})
+		list(APPEND functions ${current})
+		set(body_${current} "")
+		set(mnemonics_${current} "")
+	elseif (current STREQUAL "")
+		continue()
+	elseif (line MATCHES "^[ \t]*\\.(size|cfi_endproc)" OR line MATCHES "^[A-Za-z_][A-Za-z0-9_]*:")
+		set(current "")
+	elseif (line MATCHES "^\\.L[A-Za-z0-9_]*:")
+		list(APPEND body_${current} ".L:")
+		list(APPEND mnemonics_${current} ".L:")
+	elseif (line MATCHES "^[ \t]+[a-z]")
+		string(STRIP "${line}" instruction)
+		string(REGEX REPLACE "[ \t].*$" "" mnemonic "${instruction}")
+		string(REGEX REPLACE "[ \t]+" " " instruction "${instruction}")
+		list(APPEND body_${current} "${instruction}")
+		list(APPEND mnemonics_${current} "${mnemonic}")
+	endif()
+endforeach()
+
+set(checked 0)
+set(failures "")
+foreach(function IN LISTS functions)
+	if (NOT function MATCHES "^sf_(.*)$")
+		continue()
+	endif()
+	set(raw raw_${CMAKE_MATCH_1})
+	if (NOT DEFINED body_${raw})
+		list(APPEND failures "${function}: no ${raw} counterpart")
+		continue()
+	endif()
+	math(EXPR checked "${checked} + 1")
+	if (NOT "${mnemonics_${function}}" STREQUAL "${mnemonics_${raw}}")
+		string(REPLACE ";" "\n    " sf_listing "${body_${function}}")
+		string(REPLACE ";" "\n    " raw_listing "${body_${raw}}")
+		list(APPEND failures "${function} differs from ${raw}\n  ${function}:\n    ${sf_listing}\n  ${raw}:\n    ${raw_listing}")
+	endif()
+endforeach()
+
+if (checked EQUAL 0)
+	message(FATAL_ERROR "No sf_/raw_ function pairs found in ${OUTPUT}")
+endif()
+
+if (failures)
+	string(REPLACE ";" "\n" report "${failures}")
+	message(FATAL_ERROR "Generated code differs from raw integer code:\n${report}")
+endif()
+
+message(STATUS "${checked} operations compile to the same instructions as raw integer code")
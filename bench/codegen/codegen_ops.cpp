@@ -0,0 +1,171 @@
+#include "strong_flags/strong_flags.hpp"
+
+#include <cstdint>
+
+// Each sf_<op>_<type> function performs one operation through a strong_flags type and must compile
+// to exactly the same instructions as its raw_<op>_<type> counterpart written on the bare integer.
+// check_codegen.cmake compiles this file to assembly and compares every pair.
+
+namespace {
+
+template<typename Integer, std::size_t N>
+class flags : public strong_flags::impl<flags<Integer, N>, Integer, N> {
+private:
+    using base_type = strong_flags::impl<flags<Integer, N>, Integer, N>;
+
+public:
+    using base_type::base_type;
+};
+
+template<typename Integer>
+using full = flags<Integer, sizeof(Integer) * 8>;
+
+template<typename Integer>
+constexpr full<Integer> wrap(Integer value) {
+    return full<Integer>::from_underlying_type(value);
+}
+
+template<typename Integer>
+constexpr int raw_popcount(Integer value) {
+    return sizeof(Integer) <= sizeof(unsigned int) ? __builtin_popcount(value) : __builtin_popcountll(value);
+}
+
+template<typename Integer>
+constexpr int raw_ctz(Integer value) {
+    return sizeof(Integer) <= sizeof(unsigned int) ? __builtin_ctz(value) : __builtin_ctzll(value);
+}
+
+}
+
+#define CODEGEN_FULL_WIDTH_OPS(suffix, Integer)                                                             \
+    extern "C" Integer sf_or_##suffix(Integer a, Integer b) {                                               \
+        return (wrap(a) | wrap(b)).to_underlying_type();                                                    \
+    }                                                                                                       \
+    extern "C" Integer raw_or_##suffix(Integer a, Integer b) {                                              \
+        return static_cast<Integer>(a | b);                                                                 \
+    }                                                                                                       \
+    extern "C" Integer sf_and_##suffix(Integer a, Integer b) {                                              \
+        return (wrap(a) & wrap(b)).to_underlying_type();                                                    \
+    }                                                                                                       \
+    extern "C" Integer raw_and_##suffix(Integer a, Integer b) {                                             \
+        return static_cast<Integer>(a & b);                                                                 \
+    }                                                                                                       \
+    extern "C" Integer sf_xor_##suffix(Integer a, Integer b) {                                              \
+        return (wrap(a) ^ wrap(b)).to_underlying_type();                                                    \
+    }                                                                                                       \
+    extern "C" Integer raw_xor_##suffix(Integer a, Integer b) {                                             \
+        return static_cast<Integer>(a ^ b);                                                                 \
+    }                                                                                                       \
+    extern "C" Integer sf_not_##suffix(Integer a) {                                                         \
+        return (~wrap(a)).to_underlying_type();                                                             \
+    }                                                                                                       \
+    extern "C" Integer raw_not_##suffix(Integer a) {                                                        \
+        return static_cast<Integer>(~a);                                                                    \
+    }                                                                                                       \
+    extern "C" bool sf_eq_##suffix(Integer a, Integer b) {                                                  \
+        return wrap(a) == wrap(b);                                                                          \
+    }                                                                                                       \
+    extern "C" bool raw_eq_##suffix(Integer a, Integer b) {                                                 \
+        return a == b;                                                                                      \
+    }                                                                                                       \
+    extern "C" bool sf_test_##suffix(Integer a, std::size_t bit) {                                          \
+        return wrap(a).test(bit);                                                                           \
+    }                                                                                                       \
+    extern "C" bool raw_test_##suffix(Integer a, std::size_t bit) {                                         \
+        return ((static_cast<Integer>(1) << bit) & a) != 0;                                                \
+    }                                                                                                       \
+    extern "C" bool sf_test_any_##suffix(Integer a, Integer b) {                                            \
+        return wrap(a).test_any(wrap(b));                                                                   \
+    }                                                                                                       \
+    extern "C" bool raw_test_any_##suffix(Integer a, Integer b) {                                           \
+        return (a & b) != 0;                                                                                \
+    }                                                                                                       \
+    extern "C" bool sf_test_all_##suffix(Integer a, Integer b) {                                            \
+        return wrap(a).test_all(wrap(b));                                                                   \
+    }                                                                                                       \
+    extern "C" bool raw_test_all_##suffix(Integer a, Integer b) {                                           \
+        return (a & b) == b;                                                                                \
+    }                                                                                                       \
+    extern "C" Integer sf_set_bit_##suffix(Integer a, std::size_t bit) {                                    \
+        return wrap(a).set(bit).to_underlying_type();                                                       \
+    }                                                                                                       \
+    extern "C" Integer raw_set_bit_##suffix(Integer a, std::size_t bit) {                                   \
+        return static_cast<Integer>(a | (static_cast<Integer>(1) << bit));                                  \
+    }                                                                                                       \
+    extern "C" Integer sf_clear_bit_##suffix(Integer a, std::size_t bit) {                                  \
+        return wrap(a).clear(bit).to_underlying_type();                                                     \
+    }                                                                                                       \
+    extern "C" Integer raw_clear_bit_##suffix(Integer a, std::size_t bit) {                                 \
+        return static_cast<Integer>(a & ~(static_cast<Integer>(1) << bit));                                 \
+    }                                                                                                       \
+    extern "C" Integer sf_toggle_bit_##suffix(Integer a, std::size_t bit) {                                 \
+        return wrap(a).toggle(bit).to_underlying_type();                                                    \
+    }                                                                                                       \
+    extern "C" Integer raw_toggle_bit_##suffix(Integer a, std::size_t bit) {                                \
+        return static_cast<Integer>(a ^ (static_cast<Integer>(1) << bit));                                  \
+    }                                                                                                       \
+    extern "C" void sf_set_in_place_##suffix(full<Integer>* a, Integer b) {                                 \
+        *a |= wrap(b);                                                                                      \
+    }                                                                                                       \
+    extern "C" void raw_set_in_place_##suffix(Integer* a, Integer b) {                                      \
+        *a = static_cast<Integer>(*a | b);                                                                  \
+    }                                                                                                       \
+    extern "C" void sf_clear_in_place_##suffix(full<Integer>* a, Integer b) {                               \
+        a->clear(wrap(b));                                                                                  \
+    }                                                                                                       \
+    extern "C" void raw_clear_in_place_##suffix(Integer* a, Integer b) {                                    \
+        *a = static_cast<Integer>(*a & ~b);                                                                 \
+    }                                                                                                       \
+    extern "C" int sf_count_##suffix(Integer a) {                                                           \
+        return static_cast<int>(wrap(a).count());                                                           \
+    }                                                                                                       \
+    extern "C" int raw_count_##suffix(Integer a) {                                                          \
+        return raw_popcount(a);                                                                             \
+    }                                                                                                       \
+    extern "C" std::size_t sf_lowest_bit_##suffix(Integer a) {                                              \
+        return wrap(a).lowest_bit();                                                                        \
+    }                                                                                                       \
+    extern "C" std::size_t raw_lowest_bit_##suffix(Integer a) {                                             \
+        return a == 0 ? sizeof(Integer) * 8 : static_cast<std::size_t>(raw_ctz(a));                        \
+    }
+
+CODEGEN_FULL_WIDTH_OPS(u8, std::uint8_t)
+CODEGEN_FULL_WIDTH_OPS(u16, std::uint16_t)
+CODEGEN_FULL_WIDTH_OPS(u32, std::uint32_t)
+CODEGEN_FULL_WIDTH_OPS(u64, std::uint64_t)
+
+// Five flags in a 32 bit word: the mask has to be applied exactly where the raw code applies it.
+
+using five = flags<std::uint32_t, 5>;
+
+extern "C" std::uint32_t sf_from_underlying_m5(std::uint32_t a) {
+    return five::from_underlying_type(a).to_underlying_type();
+}
+
+extern "C" std::uint32_t raw_from_underlying_m5(std::uint32_t a) {
+    return a & 0x1FU;
+}
+
+extern "C" std::uint32_t sf_not_m5(five a) {
+    return (~a).to_underlying_type();
+}
+
+extern "C" std::uint32_t raw_not_m5(std::uint32_t a) {
+    return ~a & 0x1FU;
+}
+
+extern "C" std::uint32_t sf_set_bit_m5(five a, std::size_t bit) {
+    return a.set(bit).to_underlying_type();
+}
+
+extern "C" std::uint32_t raw_set_bit_m5(std::uint32_t a, std::size_t bit) {
+    return a | ((1U << bit) & 0x1FU);
+}
+
+extern "C" std::uint32_t sf_or_m5(five a, five b) {
+    return (a | b).to_underlying_type();
+}
+
+extern "C" std::uint32_t raw_or_m5(std::uint32_t a, std::uint32_t b) {
+    return (a | b) & 0x1FU;
+}
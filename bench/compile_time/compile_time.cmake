@@ -0,0 +1,106 @@
+
+# Generates translation units full of synthetic flag types, compiles each one with -fsyntax-only and
+# reports its compile time and memory. With MAX_SECONDS or MAX_MEMORY_MB set, a translation unit over
+# budget fails the run.
+#
+# Expected variables: COMPILER, COMPILER_ID, INCLUDE_DIR, OUTPUT_DIR, TYPES,
+#                     MAX_SECONDS (optional), MAX_MEMORY_MB (optional), TIME_TOOL (optional, GNU time)
+
+file(MAKE_DIRECTORY ${OUTPUT_DIR})
+
+# Writes ${OUTPUT_DIR}/<name>.cpp with `count` flag types of `flags` flags each.
+function(generate_tu name count flags underlying)
+	set(list "F0")
+	foreach(i RANGE 1 ${flags})
+		if (i LESS flags)
+			string(APPEND list ", F${i}")
+		endif()
+	endforeach()
+
+	set(source "#include \"strong_flags/strong_flags.hpp\"\n#include <cstdint>\n\n")
+	if (count GREATER 0)
+		math(EXPR last "${count} - 1")
+		foreach(i RANGE ${last})
+			string(APPEND source "STRONG_FLAGS_DEFINE_FLAGS(T${i}, ${underlying}, ${list});\n")
+		endforeach()
+		string(APPEND source "\nstatic_assert(T${last}::type::bit_count == ${flags}, \"\");\n")
+	endif()
+	file(WRITE ${OUTPUT_DIR}/${name}.cpp "${source}")
+endfunction()
+
+math(EXPR wide_types "(${TYPES} + 9) / 10")
+generate_tu(header_only 0 0 std::uint8_t)
+generate_tu(narrow ${TYPES} 32 std::uint32_t)
+generate_tu(full ${TYPES} 64 std::uint64_t)
+generate_tu(wide ${wide_types} 300 strong_flags::wide)
+generate_tu(large 4 1000 strong_flags::wide)
+
+set(report "translation unit      types    seconds   memory (MB)\n")
+set(failures "")
+foreach(tu header_only narrow full wide large)
+	set(command ${COMPILER} -std=c++17 -fsyntax-only -ftime-report -I${INCLUDE_DIR} ${OUTPUT_DIR}/${tu}.cpp)
+	if (TIME_TOOL)
+		set(command ${TIME_TOOL} -f "max_rss_kb %M" ${command})
+	endif()
+	execute_process(
+		COMMAND ${command}
+		RESULT_VARIABLE compile_result
+		OUTPUT_VARIABLE compile_output
+		ERROR_VARIABLE compile_output)
+	if (NOT compile_result EQUAL 0)
+		message(FATAL_ERROR "Compiling ${tu}.cpp failed:\n${compile_output}")
+	endif()
+
+	# GCC reports "TOTAL : usr sys wall mem", Clang "Total Execution Time: x seconds (wall wall clock)".
+	set(seconds "?")
+	set(memory "?")
+	if (compile_output MATCHES "TOTAL[ \t]*:[ \t]*[0-9.]+[ \t]+[0-9.]+[ \t]+([0-9.]+)[ \t]+([0-9]+)([kMG]?)")
+		set(seconds ${CMAKE_MATCH_1})
+		set(memory ${CMAKE_MATCH_2})
+		if (CMAKE_MATCH_3 STREQUAL "k" OR CMAKE_MATCH_3 STREQUAL "")
+			math(EXPR memory "${memory} / 1024")
+		elseif (CMAKE_MATCH_3 STREQUAL "G")
+			math(EXPR memory "${memory} * 1024")
+		endif()
+	elseif (compile_output MATCHES "Total Execution Time: [0-9.]+ seconds \\(([0-9.]+) wall clock\\)")
+		set(seconds ${CMAKE_MATCH_1})
+	endif()
+	# Peak resident memory is more comparable across compilers than GCC's garbage collected heap.
+	if (compile_output MATCHES "max_rss_kb ([0-9]+)")
+		math(EXPR memory "${CMAKE_MATCH_1} / 1024")
+	endif()
+
+	if (tu STREQUAL "header_only")
+		set(types 0)
+	elseif (tu STREQUAL "wide")
+		set(types ${wide_types})
+	elseif (tu STREQUAL "large")
+		set(types 4)
+	else()
+		set(types ${TYPES})
+	endif()
+
+	set(row "${tu}                    ")
+	string(SUBSTRING "${row}" 0 22 row)
+	set(cell "${types}         ")
+	string(SUBSTRING "${cell}" 0 9 cell)
+	string(APPEND row "${cell}")
+	set(cell "${seconds}          ")
+	string(SUBSTRING "${cell}" 0 10 cell)
+	string(APPEND report "${row}${cell}${memory}\n")
+
+	if (MAX_SECONDS AND NOT seconds STREQUAL "?" AND seconds GREATER MAX_SECONDS)
+		list(APPEND failures "${tu}.cpp took ${seconds} s, budget ${MAX_SECONDS} s")
+	endif()
+	if (MAX_MEMORY_MB AND NOT memory STREQUAL "?" AND memory GREATER MAX_MEMORY_MB)
+		list(APPEND failures "${tu}.cpp used ${memory} MB, budget ${MAX_MEMORY_MB} MB")
+	endif()
+endforeach()
+
+file(WRITE ${OUTPUT_DIR}/compile_time.txt "${report}")
+message("${report}")
+
+if (failures)
+	string(REPLACE ";" "\n  " failures "${failures}")
+	message(FATAL_ERROR "Compile time budget exceeded:\n  ${failures}")
+endif()
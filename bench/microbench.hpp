@@ -0,0 +1,105 @@
+
+#ifndef BENCH_MICROBENCH_H_
+#define BENCH_MICROBENCH_H_
+
+// Minimal self-contained microbenchmark harness: calibrates an iteration count per case, repeats the
+// measurement and reports the median time per operation.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace microbench {
+
+template<typename T>
+inline void do_not_optimize(T& value) {
+#if defined(__GNUC__)
+    asm volatile("" : "+m,r"(value) : : "memory");
+#else
+    volatile T sink = value;
+    (void) sink;
+#endif
+}
+
+inline void clobber_memory() {
+#if defined(__GNUC__)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+struct result {
+    std::string group;
+    std::string name;
+    double ns_per_op;
+};
+
+class registry {
+public:
+    using function_type = void (*)(std::size_t);
+
+    static registry& instance() {
+        static registry s_instance;
+        return s_instance;
+    }
+
+    void add(const char* group, const char* name, function_type function, std::size_t ops_per_call) {
+        m_cases.push_back(bench_case { group, name, function, ops_per_call });
+    }
+
+    int run(const char* filter) {
+        std::printf("%-12s %-40s %12s\n", "group", "benchmark", "ns/op");
+        for (const auto& c : m_cases) {
+            const std::string full = std::string(c.group) + "/" + c.name;
+            if (filter != nullptr && full.find(filter) == std::string::npos) {
+                continue;
+            }
+            const double ns = measure(c);
+            std::printf("%-12s %-40s %12.3f\n", c.group, c.name, ns);
+        }
+        return 0;
+    }
+
+private:
+    struct bench_case {
+        const char* group;
+        const char* name;
+        function_type function;
+        std::size_t ops_per_call;
+    };
+
+    std::vector<bench_case> m_cases;
+
+    static double measure(const bench_case& c) {
+        using clock = std::chrono::steady_clock;
+        constexpr auto target = std::chrono::milliseconds(20);
+        constexpr int repetitions = 7;
+
+        std::size_t iterations = 1;
+        while (true) {
+            const auto start = clock::now();
+            c.function(iterations);
+            if (clock::now() - start >= target || iterations >= (std::size_t { 1 } << 40)) {
+                break;
+            }
+            iterations *= 2;
+        }
+
+        std::vector<double> samples;
+        for (int r = 0; r < repetitions; ++r) {
+            const auto start = clock::now();
+            c.function(iterations);
+            const std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+            samples.push_back(elapsed.count() / static_cast<double>(iterations * c.ops_per_call));
+        }
+        std::sort(samples.begin(), samples.end());
+        return samples[samples.size() / 2];
+    }
+};
+
+}
+
+#endif /* BENCH_MICROBENCH_H_ */
@@ -0,0 +1,161 @@
+
+#ifndef INCLUDE_STRONG_FLAGS_ATOMIC_H_
+#define INCLUDE_STRONG_FLAGS_ATOMIC_H_
+
+#include "strong_flags.hpp"
+
+#include <atomic>
+#include <type_traits>
+
+namespace strong_flags {
+
+template<typename FlagType>
+class atomic {
+public:
+    using value_type = FlagType;
+    using bit_type = typename FlagType::bit_type;
+    using underlying_type = typename FlagType::underlying_type;
+
+    static constexpr bool is_always_lock_free = std::atomic<underlying_type>::is_always_lock_free;
+
+    constexpr atomic() noexcept : m_value { } {
+    }
+
+    constexpr atomic(const FlagType& value) noexcept : m_value { value.to_underlying_type() } {
+    }
+
+    atomic(const atomic&) = delete;
+    atomic& operator=(const atomic&) = delete;
+
+    bool is_lock_free() const noexcept {
+        return m_value.is_lock_free();
+    }
+
+    FlagType load(std::memory_order order = std::memory_order_seq_cst) const noexcept {
+        return FlagType::from_underlying_type(m_value.load(order));
+    }
+
+    void store(const FlagType& value, std::memory_order order = std::memory_order_seq_cst) noexcept {
+        m_value.store(value.to_underlying_type(), order);
+    }
+
+    operator FlagType() const noexcept {
+        return load();
+    }
+
+    FlagType exchange(const FlagType& value, std::memory_order order = std::memory_order_seq_cst) noexcept {
+        return FlagType::from_underlying_type(m_value.exchange(value.to_underlying_type(), order));
+    }
+
+    bool compare_exchange_weak(FlagType& expected, const FlagType& desired,
+            std::memory_order success, std::memory_order failure) noexcept {
+        auto raw = expected.to_underlying_type();
+        const bool res = m_value.compare_exchange_weak(raw, desired.to_underlying_type(), success, failure);
+        expected = FlagType::from_underlying_type(raw);
+        return res;
+    }
+
+    bool compare_exchange_weak(FlagType& expected, const FlagType& desired,
+            std::memory_order order = std::memory_order_seq_cst) noexcept {
+        return compare_exchange_weak(expected, desired, order, failure_order(order));
+    }
+
+    bool compare_exchange_strong(FlagType& expected, const FlagType& desired,
+            std::memory_order success, std::memory_order failure) noexcept {
+        auto raw = expected.to_underlying_type();
+        const bool res = m_value.compare_exchange_strong(raw, desired.to_underlying_type(), success, failure);
+        expected = FlagType::from_underlying_type(raw);
+        return res;
+    }
+
+    bool compare_exchange_strong(FlagType& expected, const FlagType& desired,
+            std::memory_order order = std::memory_order_seq_cst) noexcept {
+        return compare_exchange_strong(expected, desired, order, failure_order(order));
+    }
+
+    bool test(bit_type bit, std::memory_order order = std::memory_order_seq_cst) const noexcept {
+        return load(order).test(bit);
+    }
+
+    bool test_any(const FlagType& rhs, std::memory_order order = std::memory_order_seq_cst) const noexcept {
+        return load(order).test_any(rhs);
+    }
+
+    bool test_all(const FlagType& rhs, std::memory_order order = std::memory_order_seq_cst) const noexcept {
+        return load(order).test_all(rhs);
+    }
+
+    FlagType fetch_set(bit_type bit, std::memory_order order = std::memory_order_seq_cst) noexcept {
+        return fetch_set(FlagType::from_bit(bit), order);
+    }
+
+    FlagType fetch_set(const FlagType& rhs, std::memory_order order = std::memory_order_seq_cst) noexcept {
+        return FlagType::from_underlying_type(m_value.fetch_or(rhs.to_underlying_type(), order));
+    }
+
+    FlagType fetch_clear(bit_type bit, std::memory_order order = std::memory_order_seq_cst) noexcept {
+        return fetch_clear(FlagType::from_bit(bit), order);
+    }
+
+    FlagType fetch_clear(const FlagType& rhs, std::memory_order order = std::memory_order_seq_cst) noexcept {
+        return FlagType::from_underlying_type(
+                m_value.fetch_and(static_cast<underlying_type>(~rhs.to_underlying_type()), order));
+    }
+
+    FlagType fetch_toggle(bit_type bit, std::memory_order order = std::memory_order_seq_cst) noexcept {
+        return fetch_toggle(FlagType::from_bit(bit), order);
+    }
+
+    FlagType fetch_toggle(const FlagType& rhs, std::memory_order order = std::memory_order_seq_cst) noexcept {
+        return FlagType::from_underlying_type(m_value.fetch_xor(rhs.to_underlying_type(), order));
+    }
+
+    // Sets `flags` only if none of the bits in `guard` are currently set.
+    bool set_if_none(const FlagType& guard, const FlagType& flags,
+            std::memory_order order = std::memory_order_seq_cst) noexcept {
+        const auto guard_bits = guard.to_underlying_type();
+        const auto flag_bits = flags.to_underlying_type();
+        // A refusal is decided on this load, so it is ordered like a failed compare_exchange.
+        auto current = m_value.load(failure_order(order));
+        do {
+            if ((current & guard_bits) != 0) {
+                return false;
+            }
+        } while (!m_value.compare_exchange_weak(current, static_cast<underlying_type>(current | flag_bits),
+                order, failure_order(order)));
+        return true;
+    }
+
+    bool set_if_none(const FlagType& flags, std::memory_order order = std::memory_order_seq_cst) noexcept {
+        return set_if_none(flags, flags, order);
+    }
+
+#if defined(__cpp_lib_atomic_wait)
+    void wait(const FlagType& old, std::memory_order order = std::memory_order_seq_cst) const noexcept {
+        m_value.wait(old.to_underlying_type(), order);
+    }
+
+    void notify_one() noexcept {
+        m_value.notify_one();
+    }
+
+    void notify_all() noexcept {
+        m_value.notify_all();
+    }
+#endif
+
+private:
+    std::atomic<underlying_type> m_value;
+
+    static constexpr std::memory_order failure_order(std::memory_order order) noexcept {
+        return order == std::memory_order_acq_rel ? std::memory_order_acquire
+                : order == std::memory_order_release ? std::memory_order_relaxed : order;
+    }
+
+    static_assert(std::is_integral<underlying_type>::value,
+            "strong_flags::atomic requires an integer underlying type");
+};
+
+}
+
+#endif /* INCLUDE_STRONG_FLAGS_ATOMIC_H_ */
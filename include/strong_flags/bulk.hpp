@@ -0,0 +1,664 @@
+
+#ifndef INCLUDE_STRONG_FLAGS_BULK_H_
+#define INCLUDE_STRONG_FLAGS_BULK_H_
+
+#include "strong_flags.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace strong_flags {
+
+namespace bulk {
+
+struct parallel {
+    // 0 selects std::thread::hardware_concurrency()
+    std::size_t threads = 0;
+    // Inputs are never split into chunks smaller than this many elements.
+    std::size_t min_chunk = 1 << 16;
+};
+
+}
+
+namespace detail {
+
+#if defined(STRONG_FLAGS_SIMD_AVX2)
+constexpr std::size_t bulk_vector_bytes = 32;
+#else
+constexpr std::size_t bulk_vector_bytes = 16;
+#endif
+
+template<std::size_t Bytes>
+struct bulk_lanes;
+
+#if defined(STRONG_FLAGS_SIMD_AVX2)
+using bulk_vector = __m256i;
+
+inline bulk_vector bulk_load(const void* src) noexcept {
+    return _mm256_loadu_si256(static_cast<const __m256i*>(src));
+}
+
+inline void bulk_store(void* dst, bulk_vector value) noexcept {
+    _mm256_storeu_si256(static_cast<__m256i*>(dst), value);
+}
+
+inline std::uint32_t bulk_byte_mask(bulk_vector value) noexcept {
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(value));
+}
+
+inline bulk_vector bulk_or(bulk_vector lhs, bulk_vector rhs) noexcept {
+    return _mm256_or_si256(lhs, rhs);
+}
+
+inline bulk_vector bulk_and(bulk_vector lhs, bulk_vector rhs) noexcept {
+    return _mm256_and_si256(lhs, rhs);
+}
+
+inline bulk_vector bulk_xor(bulk_vector lhs, bulk_vector rhs) noexcept {
+    return _mm256_xor_si256(lhs, rhs);
+}
+
+// lhs & ~rhs
+inline bulk_vector bulk_andnot(bulk_vector lhs, bulk_vector rhs) noexcept {
+    return _mm256_andnot_si256(rhs, lhs);
+}
+
+template<>
+struct bulk_lanes<1> {
+    static bulk_vector broadcast(std::uint8_t value) noexcept {
+        return _mm256_set1_epi8(static_cast<char>(value));
+    }
+
+    static bulk_vector equal(bulk_vector lhs, bulk_vector rhs) noexcept {
+        return _mm256_cmpeq_epi8(lhs, rhs);
+    }
+
+    static bulk_vector subtract(bulk_vector lhs, bulk_vector rhs) noexcept {
+        return _mm256_sub_epi8(lhs, rhs);
+    }
+};
+
+template<>
+struct bulk_lanes<2> {
+    static bulk_vector broadcast(std::uint16_t value) noexcept {
+        return _mm256_set1_epi16(static_cast<short>(value));
+    }
+
+    static bulk_vector equal(bulk_vector lhs, bulk_vector rhs) noexcept {
+        return _mm256_cmpeq_epi16(lhs, rhs);
+    }
+
+    static bulk_vector subtract(bulk_vector lhs, bulk_vector rhs) noexcept {
+        return _mm256_sub_epi16(lhs, rhs);
+    }
+};
+
+template<>
+struct bulk_lanes<4> {
+    static bulk_vector broadcast(std::uint32_t value) noexcept {
+        return _mm256_set1_epi32(static_cast<int>(value));
+    }
+
+    static bulk_vector equal(bulk_vector lhs, bulk_vector rhs) noexcept {
+        return _mm256_cmpeq_epi32(lhs, rhs);
+    }
+
+    static bulk_vector subtract(bulk_vector lhs, bulk_vector rhs) noexcept {
+        return _mm256_sub_epi32(lhs, rhs);
+    }
+};
+
+template<>
+struct bulk_lanes<8> {
+    static bulk_vector broadcast(std::uint64_t value) noexcept {
+        return _mm256_set1_epi64x(static_cast<long long>(value));
+    }
+
+    static bulk_vector equal(bulk_vector lhs, bulk_vector rhs) noexcept {
+        return _mm256_cmpeq_epi64(lhs, rhs);
+    }
+
+    static bulk_vector subtract(bulk_vector lhs, bulk_vector rhs) noexcept {
+        return _mm256_sub_epi64(lhs, rhs);
+    }
+};
+#elif defined(STRONG_FLAGS_SIMD_SSE2)
+using bulk_vector = __m128i;
+
+inline bulk_vector bulk_load(const void* src) noexcept {
+    return _mm_loadu_si128(static_cast<const __m128i*>(src));
+}
+
+inline void bulk_store(void* dst, bulk_vector value) noexcept {
+    _mm_storeu_si128(static_cast<__m128i*>(dst), value);
+}
+
+inline std::uint32_t bulk_byte_mask(bulk_vector value) noexcept {
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(value));
+}
+
+inline bulk_vector bulk_or(bulk_vector lhs, bulk_vector rhs) noexcept {
+    return _mm_or_si128(lhs, rhs);
+}
+
+inline bulk_vector bulk_and(bulk_vector lhs, bulk_vector rhs) noexcept {
+    return _mm_and_si128(lhs, rhs);
+}
+
+inline bulk_vector bulk_xor(bulk_vector lhs, bulk_vector rhs) noexcept {
+    return _mm_xor_si128(lhs, rhs);
+}
+
+// lhs & ~rhs
+inline bulk_vector bulk_andnot(bulk_vector lhs, bulk_vector rhs) noexcept {
+    return _mm_andnot_si128(rhs, lhs);
+}
+
+template<>
+struct bulk_lanes<1> {
+    static bulk_vector broadcast(std::uint8_t value) noexcept {
+        return _mm_set1_epi8(static_cast<char>(value));
+    }
+
+    static bulk_vector equal(bulk_vector lhs, bulk_vector rhs) noexcept {
+        return _mm_cmpeq_epi8(lhs, rhs);
+    }
+
+    static bulk_vector subtract(bulk_vector lhs, bulk_vector rhs) noexcept {
+        return _mm_sub_epi8(lhs, rhs);
+    }
+};
+
+template<>
+struct bulk_lanes<2> {
+    static bulk_vector broadcast(std::uint16_t value) noexcept {
+        return _mm_set1_epi16(static_cast<short>(value));
+    }
+
+    static bulk_vector equal(bulk_vector lhs, bulk_vector rhs) noexcept {
+        return _mm_cmpeq_epi16(lhs, rhs);
+    }
+
+    static bulk_vector subtract(bulk_vector lhs, bulk_vector rhs) noexcept {
+        return _mm_sub_epi16(lhs, rhs);
+    }
+};
+
+template<>
+struct bulk_lanes<4> {
+    static bulk_vector broadcast(std::uint32_t value) noexcept {
+        return _mm_set1_epi32(static_cast<int>(value));
+    }
+
+    static bulk_vector equal(bulk_vector lhs, bulk_vector rhs) noexcept {
+        return _mm_cmpeq_epi32(lhs, rhs);
+    }
+
+    static bulk_vector subtract(bulk_vector lhs, bulk_vector rhs) noexcept {
+        return _mm_sub_epi32(lhs, rhs);
+    }
+};
+
+template<>
+struct bulk_lanes<8> {
+    static bulk_vector broadcast(std::uint64_t value) noexcept {
+        return _mm_set1_epi64x(static_cast<long long>(value));
+    }
+
+    // SSE2 has no 64 bit compare: both 32 bit halves have to match.
+    static bulk_vector equal(bulk_vector lhs, bulk_vector rhs) noexcept {
+        const bulk_vector halves = _mm_cmpeq_epi32(lhs, rhs);
+        return _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+
+    static bulk_vector subtract(bulk_vector lhs, bulk_vector rhs) noexcept {
+        return _mm_sub_epi64(lhs, rhs);
+    }
+};
+#endif
+
+// Kernels over raw unsigned words. Matches are reported per block as a byte mask where lane k sets
+// bit k * sizeof(T), the layout movemask produces, so scalar tails and vector blocks share consumers.
+template<typename T>
+struct bulk_kernels {
+    static constexpr std::size_t s_lanes = bulk_vector_bytes / sizeof(T);
+
+    static bool match(T value, T mask, bool all) noexcept {
+        return all ? (value & mask) == mask : (value & mask) != 0;
+    }
+
+    template<typename Visitor>
+    static void scan(const T* data, std::size_t count, T mask, bool all, Visitor&& visit) noexcept {
+        std::size_t i = 0;
+#if defined(STRONG_FLAGS_SIMD_AVX2) || defined(STRONG_FLAGS_SIMD_SSE2)
+        using lanes = bulk_lanes<sizeof(T)>;
+        const bulk_vector vmask = lanes::broadcast(mask);
+        const bulk_vector target = all ? vmask : bulk_vector { };
+        for (; i + s_lanes <= count; i += s_lanes) {
+            const bulk_vector hits = lanes::equal(bulk_and(bulk_load(data + i), vmask), target);
+            std::uint32_t bits = bulk_byte_mask(hits) & lane_pattern();
+            if (!all) {
+                bits ^= lane_pattern();
+            }
+            visit(i, bits);
+        }
+#endif
+        while (i < count) {
+            const std::size_t end = std::min(count, i + s_lanes);
+            std::uint32_t bits = 0;
+            for (std::size_t k = i; k < end; ++k) {
+                bits |= static_cast<std::uint32_t>(match(data[k], mask, all)) << ((k - i) * sizeof(T));
+            }
+            visit(i, bits);
+            i = end;
+        }
+    }
+
+    static constexpr std::uint32_t lane_pattern() noexcept {
+        return (sizeof(T) == 1 ? 0xFFFFFFFFU
+                : sizeof(T) == 2 ? 0x55555555U
+                : sizeof(T) == 4 ? 0x11111111U : 0x01010101U) >> (32 - bulk_vector_bytes);
+    }
+
+    static std::size_t count(const T* data, std::size_t count, T mask, bool all) noexcept {
+        std::size_t res = 0;
+        scan(data, count, mask, all, [&res](std::size_t, std::uint32_t bits) {
+            res += static_cast<std::size_t>(popcount(bits));
+        });
+        return res;
+    }
+
+    static std::size_t select(const T* data, std::size_t count, T mask, bool all, std::size_t* indices) noexcept {
+        std::size_t res = 0;
+        scan(data, count, mask, all, [&res, indices](std::size_t base, std::uint32_t bits) {
+            for (; bits != 0; bits &= bits - 1) {
+                indices[res++] = base + static_cast<std::size_t>(countr_zero(bits)) / sizeof(T);
+            }
+        });
+        return res;
+    }
+
+    static void select_bitmap(const T* data, std::size_t count, T mask, bool all, std::uint64_t* bitmap) noexcept {
+        std::fill(bitmap, bitmap + (count + 63) / 64, std::uint64_t { 0 });
+        scan(data, count, mask, all, [bitmap](std::size_t base, std::uint32_t bits) {
+            for (; bits != 0; bits &= bits - 1) {
+                const std::size_t index = base + static_cast<std::size_t>(countr_zero(bits)) / sizeof(T);
+                bitmap[index / 64] |= std::uint64_t { 1 } << (index % 64);
+            }
+        });
+    }
+
+    static void set(T* data, std::size_t count, T mask) noexcept {
+        std::size_t i = 0;
+#if defined(STRONG_FLAGS_SIMD_AVX2) || defined(STRONG_FLAGS_SIMD_SSE2)
+        const bulk_vector vmask = bulk_lanes<sizeof(T)>::broadcast(mask);
+        for (; i + s_lanes <= count; i += s_lanes) {
+            bulk_store(data + i, bulk_or(bulk_load(data + i), vmask));
+        }
+#endif
+        for (; i < count; ++i) {
+            data[i] = static_cast<T>(data[i] | mask);
+        }
+    }
+
+    static void clear(T* data, std::size_t count, T mask) noexcept {
+        std::size_t i = 0;
+#if defined(STRONG_FLAGS_SIMD_AVX2) || defined(STRONG_FLAGS_SIMD_SSE2)
+        const bulk_vector vmask = bulk_lanes<sizeof(T)>::broadcast(mask);
+        for (; i + s_lanes <= count; i += s_lanes) {
+            bulk_store(data + i, bulk_andnot(bulk_load(data + i), vmask));
+        }
+#endif
+        for (; i < count; ++i) {
+            data[i] = static_cast<T>(data[i] & ~mask);
+        }
+    }
+
+    static void toggle(T* data, std::size_t count, T mask) noexcept {
+        std::size_t i = 0;
+#if defined(STRONG_FLAGS_SIMD_AVX2) || defined(STRONG_FLAGS_SIMD_SSE2)
+        const bulk_vector vmask = bulk_lanes<sizeof(T)>::broadcast(mask);
+        for (; i + s_lanes <= count; i += s_lanes) {
+            bulk_store(data + i, bulk_xor(bulk_load(data + i), vmask));
+        }
+#endif
+        for (; i < count; ++i) {
+            data[i] = static_cast<T>(data[i] ^ mask);
+        }
+    }
+
+    static T reduce_or(const T* data, std::size_t count) noexcept {
+        T res = 0;
+        std::size_t i = 0;
+#if defined(STRONG_FLAGS_SIMD_AVX2) || defined(STRONG_FLAGS_SIMD_SSE2)
+        if (count >= s_lanes) {
+            bulk_vector acc { };
+            for (; i + s_lanes <= count; i += s_lanes) {
+                acc = bulk_or(acc, bulk_load(data + i));
+            }
+            T lanes[s_lanes];
+            bulk_store(lanes, acc);
+            for (T lane : lanes) {
+                res = static_cast<T>(res | lane);
+            }
+        }
+#endif
+        for (; i < count; ++i) {
+            res = static_cast<T>(res | data[i]);
+        }
+        return res;
+    }
+
+    static T reduce_and(const T* data, std::size_t count) noexcept {
+        T res = static_cast<T>(~T { 0 });
+        std::size_t i = 0;
+#if defined(STRONG_FLAGS_SIMD_AVX2) || defined(STRONG_FLAGS_SIMD_SSE2)
+        if (count >= s_lanes) {
+            bulk_vector acc = bulk_lanes<sizeof(T)>::broadcast(res);
+            for (; i + s_lanes <= count; i += s_lanes) {
+                acc = bulk_and(acc, bulk_load(data + i));
+            }
+            T lanes[s_lanes];
+            bulk_store(lanes, acc);
+            for (T lane : lanes) {
+                res = static_cast<T>(res & lane);
+            }
+        }
+#endif
+        for (; i < count; ++i) {
+            res = static_cast<T>(res & data[i]);
+        }
+        return res;
+    }
+};
+
+template<typename FlagType>
+struct bulk_traits {
+    using underlying_type = typename FlagType::underlying_type;
+
+    static constexpr bool s_raw = std::is_integral<underlying_type>::value;
+
+    using word_type = typename std::conditional<s_raw,
+            std::make_unsigned<underlying_type>, std::common_type<underlying_type>>::type::type;
+
+    static_assert(sizeof(FlagType) == sizeof(underlying_type), "Flag type must have the size of its underlying type");
+    static_assert(std::is_standard_layout<FlagType>::value, "Flag type must be standard layout");
+
+    static const word_type* words(const FlagType* values) noexcept {
+        return reinterpret_cast<const word_type*>(values);
+    }
+
+    static word_type* words(FlagType* values) noexcept {
+        return reinterpret_cast<word_type*>(values);
+    }
+
+    static word_type word(const FlagType& value) noexcept {
+        return static_cast<word_type>(value.to_underlying_type());
+    }
+};
+
+inline std::size_t parallel_threads(const bulk::parallel& policy, std::size_t count) noexcept {
+    const std::size_t threads = policy.threads != 0 ? policy.threads : std::thread::hardware_concurrency();
+    return std::max<std::size_t>(1, std::min(threads, count / std::max<std::size_t>(policy.min_chunk, 1)));
+}
+
+// Calls function(chunk, begin, end) for `threads` contiguous chunks, chunk 0 on the calling thread.
+template<typename Function>
+void parallel_chunks(std::size_t threads, std::size_t count, Function&& function) {
+    if (threads <= 1) {
+        function(std::size_t { 0 }, std::size_t { 0 }, count);
+        return;
+    }
+
+    const std::size_t chunk = (count + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (std::size_t t = 1; t < threads; ++t) {
+        const std::size_t begin = std::min(count, t * chunk);
+        const std::size_t end = std::min(count, begin + chunk);
+        workers.emplace_back([&function, t, begin, end] {
+            function(t, begin, end);
+        });
+    }
+    function(std::size_t { 0 }, std::size_t { 0 }, std::min(count, chunk));
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+template<typename FlagType>
+std::size_t bulk_count(const FlagType* values, std::size_t count, const FlagType& mask, bool all) noexcept {
+    using traits = bulk_traits<FlagType>;
+    if constexpr (traits::s_raw) {
+        return bulk_kernels<typename traits::word_type>::count(traits::words(values), count, traits::word(mask), all);
+    } else {
+        std::size_t res = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            res += all ? values[i].test_all(mask) : values[i].test_any(mask);
+        }
+        return res;
+    }
+}
+
+template<typename FlagType>
+std::size_t bulk_select(const FlagType* values, std::size_t count, const FlagType& mask, bool all,
+        std::size_t* indices) noexcept {
+    using traits = bulk_traits<FlagType>;
+    if constexpr (traits::s_raw) {
+        return bulk_kernels<typename traits::word_type>::select(traits::words(values), count, traits::word(mask), all,
+                indices);
+    } else {
+        std::size_t res = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (all ? values[i].test_all(mask) : values[i].test_any(mask)) {
+                indices[res++] = i;
+            }
+        }
+        return res;
+    }
+}
+
+template<typename FlagType>
+void bulk_select_bitmap(const FlagType* values, std::size_t count, const FlagType& mask, bool all,
+        std::uint64_t* bitmap) noexcept {
+    using traits = bulk_traits<FlagType>;
+    if constexpr (traits::s_raw) {
+        bulk_kernels<typename traits::word_type>::select_bitmap(traits::words(values), count, traits::word(mask), all,
+                bitmap);
+    } else {
+        std::fill(bitmap, bitmap + (count + 63) / 64, std::uint64_t { 0 });
+        for (std::size_t i = 0; i < count; ++i) {
+            if (all ? values[i].test_all(mask) : values[i].test_any(mask)) {
+                bitmap[i / 64] |= std::uint64_t { 1 } << (i % 64);
+            }
+        }
+    }
+}
+
+}
+
+namespace bulk {
+
+template<typename FlagType>
+std::size_t count_any(const FlagType* values, std::size_t count, const FlagType& mask) noexcept {
+    return detail::bulk_count(values, count, mask, false);
+}
+
+template<typename FlagType>
+std::size_t count_all(const FlagType* values, std::size_t count, const FlagType& mask) noexcept {
+    return detail::bulk_count(values, count, mask, true);
+}
+
+template<typename FlagType>
+std::size_t count_any(const parallel& policy, const FlagType* values, std::size_t count, const FlagType& mask) {
+    const std::size_t threads = detail::parallel_threads(policy, count);
+    std::vector<std::size_t> partial(threads);
+    detail::parallel_chunks(threads, count, [&](std::size_t t, std::size_t begin, std::size_t end) {
+        partial[t] = count_any(values + begin, end - begin, mask);
+    });
+    std::size_t res = 0;
+    for (auto n : partial) {
+        res += n;
+    }
+    return res;
+}
+
+template<typename FlagType>
+std::size_t count_all(const parallel& policy, const FlagType* values, std::size_t count, const FlagType& mask) {
+    const std::size_t threads = detail::parallel_threads(policy, count);
+    std::vector<std::size_t> partial(threads);
+    detail::parallel_chunks(threads, count, [&](std::size_t t, std::size_t begin, std::size_t end) {
+        partial[t] = count_all(values + begin, end - begin, mask);
+    });
+    std::size_t res = 0;
+    for (auto n : partial) {
+        res += n;
+    }
+    return res;
+}
+
+// Writes the index of every matching element to `indices`, which must have room for `count` entries.
+// Returns the number of indices written.
+template<typename FlagType>
+std::size_t select_any(const FlagType* values, std::size_t count, const FlagType& mask, std::size_t* indices) noexcept {
+    return detail::bulk_select(values, count, mask, false, indices);
+}
+
+template<typename FlagType>
+std::size_t select_all(const FlagType* values, std::size_t count, const FlagType& mask, std::size_t* indices) noexcept {
+    return detail::bulk_select(values, count, mask, true, indices);
+}
+
+// Sets bit i of `bitmap` for every matching element i; writes all (count + 63) / 64 words.
+template<typename FlagType>
+void select_any_bitmap(const FlagType* values, std::size_t count, const FlagType& mask,
+        std::uint64_t* bitmap) noexcept {
+    detail::bulk_select_bitmap(values, count, mask, false, bitmap);
+}
+
+template<typename FlagType>
+void select_all_bitmap(const FlagType* values, std::size_t count, const FlagType& mask,
+        std::uint64_t* bitmap) noexcept {
+    detail::bulk_select_bitmap(values, count, mask, true, bitmap);
+}
+
+template<typename FlagType>
+void set(FlagType* values, std::size_t count, const FlagType& mask) noexcept {
+    using traits = detail::bulk_traits<FlagType>;
+    if constexpr (traits::s_raw) {
+        detail::bulk_kernels<typename traits::word_type>::set(traits::words(values), count, traits::word(mask));
+    } else {
+        for (std::size_t i = 0; i < count; ++i) {
+            values[i].set(mask);
+        }
+    }
+}
+
+template<typename FlagType>
+void clear(FlagType* values, std::size_t count, const FlagType& mask) noexcept {
+    using traits = detail::bulk_traits<FlagType>;
+    if constexpr (traits::s_raw) {
+        detail::bulk_kernels<typename traits::word_type>::clear(traits::words(values), count, traits::word(mask));
+    } else {
+        for (std::size_t i = 0; i < count; ++i) {
+            values[i].clear(mask);
+        }
+    }
+}
+
+template<typename FlagType>
+void toggle(FlagType* values, std::size_t count, const FlagType& mask) noexcept {
+    using traits = detail::bulk_traits<FlagType>;
+    if constexpr (traits::s_raw) {
+        detail::bulk_kernels<typename traits::word_type>::toggle(traits::words(values), count, traits::word(mask));
+    } else {
+        for (std::size_t i = 0; i < count; ++i) {
+            values[i].toggle(mask);
+        }
+    }
+}
+
+template<typename FlagType>
+void set(const parallel& policy, FlagType* values, std::size_t count, const FlagType& mask) {
+    detail::parallel_chunks(detail::parallel_threads(policy, count), count,
+            [&](std::size_t, std::size_t begin, std::size_t end) {
+        set(values + begin, end - begin, mask);
+    });
+}
+
+template<typename FlagType>
+void clear(const parallel& policy, FlagType* values, std::size_t count, const FlagType& mask) {
+    detail::parallel_chunks(detail::parallel_threads(policy, count), count,
+            [&](std::size_t, std::size_t begin, std::size_t end) {
+        clear(values + begin, end - begin, mask);
+    });
+}
+
+template<typename FlagType>
+void toggle(const parallel& policy, FlagType* values, std::size_t count, const FlagType& mask) {
+    detail::parallel_chunks(detail::parallel_threads(policy, count), count,
+            [&](std::size_t, std::size_t begin, std::size_t end) {
+        toggle(values + begin, end - begin, mask);
+    });
+}
+
+template<typename FlagType>
+FlagType reduce_or(const FlagType* values, std::size_t count) noexcept {
+    using traits = detail::bulk_traits<FlagType>;
+    if constexpr (traits::s_raw) {
+        return FlagType::from_underlying_type(static_cast<typename FlagType::underlying_type>(
+                detail::bulk_kernels<typename traits::word_type>::reduce_or(traits::words(values), count)));
+    } else {
+        FlagType res;
+        for (std::size_t i = 0; i < count; ++i) {
+            res |= values[i];
+        }
+        return res;
+    }
+}
+
+// Returns every flag set for an empty range.
+template<typename FlagType>
+FlagType reduce_and(const FlagType* values, std::size_t count) noexcept {
+    using traits = detail::bulk_traits<FlagType>;
+    if constexpr (traits::s_raw) {
+        return FlagType::from_underlying_type(static_cast<typename FlagType::underlying_type>(
+                detail::bulk_kernels<typename traits::word_type>::reduce_and(traits::words(values), count)));
+    } else {
+        auto res = ~FlagType();
+        for (std::size_t i = 0; i < count; ++i) {
+            res &= values[i];
+        }
+        return res;
+    }
+}
+
+template<typename FlagType>
+FlagType reduce_or(const parallel& policy, const FlagType* values, std::size_t count) {
+    const std::size_t threads = detail::parallel_threads(policy, count);
+    std::vector<FlagType> partial(threads);
+    detail::parallel_chunks(threads, count, [&](std::size_t t, std::size_t begin, std::size_t end) {
+        partial[t] = reduce_or(values + begin, end - begin);
+    });
+    return reduce_or(partial.data(), partial.size());
+}
+
+template<typename FlagType>
+FlagType reduce_and(const parallel& policy, const FlagType* values, std::size_t count) {
+    const std::size_t threads = detail::parallel_threads(policy, count);
+    std::vector<FlagType> partial(threads, ~FlagType());
+    detail::parallel_chunks(threads, count, [&](std::size_t t, std::size_t begin, std::size_t end) {
+        partial[t] = reduce_and(values + begin, end - begin);
+    });
+    return reduce_and(partial.data(), partial.size());
+}
+
+}
+
+}
+
+#endif /* INCLUDE_STRONG_FLAGS_BULK_H_ */
@@ -0,0 +1,467 @@
+
+#ifndef INCLUDE_STRONG_FLAGS_CODEC_H_
+#define INCLUDE_STRONG_FLAGS_CODEC_H_
+
+#include "strong_flags.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// Stream layout: a header (magic, version, bit count, word count, 64 bit type fingerprint) followed by
+// records, each describing the XOR of a value with the previous one (the first value is XORed with
+// zero). A record starts with a tag byte whose two low bits select the kind and whose six high bits
+// hold a small argument; an argument of 63 means the real argument minus 63 follows as a varint.
+//
+//   run      the previous value repeats (argument + 1) times
+//   flip     a single bit, given by the argument, changed
+//   literal  arbitrary delta, one varint per 64 bit word follows (argument must be 0)
+
+namespace strong_flags {
+
+enum class decode_status {
+    ok,
+    end,
+    bad_header,
+    type_mismatch,
+    corrupt,
+    io_error
+};
+
+namespace detail {
+
+constexpr std::uint8_t codec_magic[4] = { 'S', 'F', 'D', 'C' };
+constexpr std::uint8_t codec_version = 1;
+
+constexpr std::uint8_t codec_run = 0;
+constexpr std::uint8_t codec_flip = 1;
+constexpr std::uint8_t codec_literal = 2;
+constexpr std::uint8_t codec_inline_limit = 63;
+constexpr std::size_t codec_max_varint = 10;
+
+inline std::uint8_t* write_varint(std::uint8_t* out, std::uint64_t value) noexcept {
+    while (value >= 0x80) {
+        *out++ = static_cast<std::uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = static_cast<std::uint8_t>(value);
+    return out;
+}
+
+// Returns nullptr if the varint is truncated or longer than 64 bits.
+inline const std::uint8_t* read_varint(const std::uint8_t* in, const std::uint8_t* end,
+        std::uint64_t& value) noexcept {
+    value = 0;
+    for (unsigned shift = 0; shift < 64 && in != end; shift += 7) {
+        const std::uint8_t byte = *in++;
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return in;
+        }
+    }
+    return nullptr;
+}
+
+template<typename FlagType, bool = std::is_integral<typename FlagType::underlying_type>::value>
+struct codec_traits {
+    using underlying_type = typename FlagType::underlying_type;
+    using unsigned_type = typename std::make_unsigned<underlying_type>::type;
+
+    static constexpr std::size_t s_words = 1;
+
+    static std::uint64_t word(const FlagType& value, std::size_t) noexcept {
+        return static_cast<unsigned_type>(value.to_underlying_type());
+    }
+
+    // Returns false if the delta has bits outside of the flag type.
+    static bool apply(FlagType& value, const std::uint64_t* delta) noexcept {
+        const auto bits = static_cast<unsigned_type>(delta[0]);
+        const auto next = FlagType::from_underlying_type(static_cast<underlying_type>(word(value, 0) ^ bits));
+        if (bits != delta[0] || (word(next, 0) ^ word(value, 0)) != bits) {
+            return false;
+        }
+        value = next;
+        return true;
+    }
+};
+
+template<typename FlagType>
+struct codec_traits<FlagType, false> {
+    using underlying_type = typename FlagType::underlying_type;
+
+    static constexpr std::size_t s_words = (FlagType::bit_count + 63) / 64;
+
+    static std::uint64_t word(const FlagType& value, std::size_t index) noexcept {
+        return value.to_underlying_type().word(index);
+    }
+
+    static bool apply(FlagType& value, const std::uint64_t* delta) noexcept {
+        underlying_type bits = value.to_underlying_type();
+        for (std::size_t i = 0; i < s_words; ++i) {
+            bits.word(i) ^= delta[i];
+        }
+        const auto next = FlagType::from_underlying_type(bits);
+        if (next.to_underlying_type() != bits) {
+            return false;
+        }
+        value = next;
+        return true;
+    }
+};
+
+template<typename FlagType, typename = void>
+struct codec_names {
+    static constexpr std::uint64_t hash(std::uint64_t seed) noexcept {
+        return seed;
+    }
+};
+
+template<typename FlagType>
+struct codec_names<FlagType, decltype((void) FlagType::names)> {
+    static constexpr std::uint64_t hash(std::uint64_t seed) noexcept {
+        for (std::string_view name : FlagType::names) {
+            for (char c : name) {
+                seed = (seed ^ static_cast<unsigned char>(c)) * 0x100000001b3ULL;
+            }
+            seed = (seed ^ 0xFF) * 0x100000001b3ULL;
+        }
+        return seed;
+    }
+};
+
+// Identifies the flag type in a stream header: the bit count and, for types with a name table, the
+// flag names in order. Renaming, adding or reordering flags makes old streams fail to decode.
+template<typename FlagType>
+constexpr std::uint64_t codec_fingerprint() noexcept {
+    std::uint64_t seed = 0xcbf29ce484222325ULL;
+    for (std::uint64_t n = FlagType::bit_count; n != 0; n >>= 8) {
+        seed = (seed ^ (n & 0xFF)) * 0x100000001b3ULL;
+    }
+    return codec_names<FlagType>::hash(seed);
+}
+
+constexpr std::size_t codec_header_size = 4 + 1 + 2 * codec_max_varint + 8;
+
+template<typename FlagType>
+constexpr std::size_t codec_max_record = 1 + codec_max_varint * codec_traits<FlagType>::s_words;
+
+}
+
+// Delta encodes a sequence of values into an internal byte buffer. The header is written on
+// construction; call finish() after the last value, then take the bytes with data()/size() or
+// write_to(). Bytes can be drained at any point to stream the output.
+template<typename FlagType>
+class encoder {
+public:
+    using flag_type = FlagType;
+
+    encoder() : m_previous { }, m_run { 0 } {
+        using traits = detail::codec_traits<FlagType>;
+
+        std::uint8_t header[detail::codec_header_size];
+        std::uint8_t* out = std::copy(std::begin(detail::codec_magic), std::end(detail::codec_magic), header);
+        *out++ = detail::codec_version;
+        out = detail::write_varint(out, FlagType::bit_count);
+        out = detail::write_varint(out, traits::s_words);
+        const std::uint64_t fingerprint = detail::codec_fingerprint<FlagType>();
+        for (unsigned i = 0; i < 8; ++i) {
+            *out++ = static_cast<std::uint8_t>(fingerprint >> (8 * i));
+        }
+        m_buffer.assign(header, out);
+    }
+
+    void push(const FlagType& value) {
+        using traits = detail::codec_traits<FlagType>;
+
+        if (value == m_previous) {
+            ++m_run;
+            return;
+        }
+        flush_run();
+
+        std::uint64_t delta[traits::s_words];
+        std::size_t changed_words = 0;
+        std::size_t changed_word = 0;
+        for (std::size_t i = 0; i < traits::s_words; ++i) {
+            delta[i] = traits::word(value, i) ^ traits::word(m_previous, i);
+            if (delta[i] != 0) {
+                ++changed_words;
+                changed_word = i;
+            }
+        }
+
+        const std::size_t size = m_buffer.size();
+        m_buffer.resize(size + detail::codec_max_record<FlagType>);
+        std::uint8_t* out = m_buffer.data() + size;
+        const std::uint64_t word = delta[changed_word];
+        if (changed_words == 1 && (word & (word - 1)) == 0) {
+            const auto bit = changed_word * 64 + static_cast<std::size_t>(detail::countr_zero(word));
+            out = write_tag(out, detail::codec_flip, bit);
+        } else {
+            *out++ = detail::codec_literal;
+            for (std::size_t i = 0; i < traits::s_words; ++i) {
+                out = detail::write_varint(out, delta[i]);
+            }
+        }
+        m_buffer.resize(static_cast<std::size_t>(out - m_buffer.data()));
+        m_previous = value;
+    }
+
+    void push(const FlagType* values, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            push(values[i]);
+        }
+    }
+
+    // Writes out a pending run of repeated values. Encoding can continue afterwards.
+    void finish() {
+        flush_run();
+    }
+
+    const std::uint8_t* data() const noexcept {
+        return m_buffer.data();
+    }
+
+    std::size_t size() const noexcept {
+        return m_buffer.size();
+    }
+
+    // Drops the buffered bytes; the delta state is kept so the next bytes continue the stream.
+    void clear() noexcept {
+        m_buffer.clear();
+    }
+
+    // Writes and drops the buffered bytes. Returns false if the stream failed.
+    bool write_to(std::ostream& out) {
+        out.write(reinterpret_cast<const char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()));
+        m_buffer.clear();
+        return static_cast<bool>(out);
+    }
+
+private:
+    std::vector<std::uint8_t> m_buffer;
+    FlagType m_previous;
+    std::size_t m_run;
+
+    static std::uint8_t* write_tag(std::uint8_t* out, std::uint8_t kind, std::uint64_t argument) noexcept {
+        if (argument < detail::codec_inline_limit) {
+            *out++ = static_cast<std::uint8_t>(kind | (argument << 2));
+            return out;
+        }
+        *out++ = static_cast<std::uint8_t>(kind | (detail::codec_inline_limit << 2));
+        return detail::write_varint(out, argument - detail::codec_inline_limit);
+    }
+
+    void flush_run() {
+        if (m_run == 0) {
+            return;
+        }
+        const std::size_t size = m_buffer.size();
+        m_buffer.resize(size + 1 + detail::codec_max_varint);
+        const std::uint8_t* end = write_tag(m_buffer.data() + size, detail::codec_run, m_run - 1);
+        m_buffer.resize(static_cast<std::size_t>(end - m_buffer.data()));
+        m_run = 0;
+    }
+};
+
+// Decodes a stream written by encoder<FlagType>, either from a memory buffer or by pulling fixed
+// size chunks from a std::istream. Runs of repeated values are expanded with plain fills straight
+// into the caller's buffer.
+template<typename FlagType>
+class decoder {
+public:
+    using flag_type = FlagType;
+
+    static constexpr std::size_t default_chunk_size = 1 << 16;
+
+    // The buffer is not copied and must outlive the decoder.
+    decoder(const void* data, std::size_t size) noexcept :
+            m_stream { nullptr }, m_pos { static_cast<const std::uint8_t*>(data) }, m_end { m_pos + size },
+            m_previous { }, m_pending { 0 }, m_status { decode_status::ok } {
+        read_header();
+    }
+
+    explicit decoder(std::istream& in, std::size_t chunk_size = default_chunk_size) :
+            m_stream { &in }, m_chunk(std::max({ chunk_size, detail::codec_header_size, 2 * detail::codec_max_record<FlagType> })),
+            m_pos { m_chunk.data() }, m_end { m_chunk.data() }, m_previous { }, m_pending { 0 },
+            m_status { decode_status::ok } {
+        read_header();
+    }
+
+    // A stream decoder points into its own chunk, which a copy would not share. Moving keeps the chunk.
+    decoder(const decoder&) = delete;
+    decoder& operator=(const decoder&) = delete;
+    decoder(decoder&&) = default;
+    decoder& operator=(decoder&&) = default;
+
+    decode_status status() const noexcept {
+        return m_status;
+    }
+
+    // Decodes up to `capacity` values into `out`. Returns the number of values written, which is less
+    // than `capacity` only when the stream ended or failed; status() tells which.
+    std::size_t read(FlagType* out, std::size_t capacity) {
+        std::size_t produced = 0;
+        while (produced < capacity) {
+            if (m_pending != 0) {
+                const std::size_t n = static_cast<std::size_t>(
+                        std::min<std::uint64_t>(m_pending, capacity - produced));
+                std::fill_n(out + produced, n, m_previous);
+                produced += n;
+                m_pending -= n;
+                continue;
+            }
+            if (m_status != decode_status::ok || !next_record()) {
+                break;
+            }
+            if (m_pending == 0) {
+                out[produced++] = m_previous;
+            }
+        }
+        return produced;
+    }
+
+    // Decodes everything that is left, appending to `out`.
+    decode_status read_all(std::vector<FlagType>& out) {
+        constexpr std::size_t batch = 4096;
+        while (true) {
+            const std::size_t size = out.size();
+            out.resize(size + batch);
+            const std::size_t n = read(out.data() + size, batch);
+            out.resize(size + n);
+            if (n < batch) {
+                return m_status;
+            }
+        }
+    }
+
+private:
+    using traits = detail::codec_traits<FlagType>;
+
+    std::istream* m_stream;
+    std::vector<std::uint8_t> m_chunk;
+    const std::uint8_t* m_pos;
+    const std::uint8_t* m_end;
+    FlagType m_previous;
+    std::uint64_t m_pending;
+    decode_status m_status;
+
+    // Makes at least `bytes` bytes available unless the input ends first.
+    void fill(std::size_t bytes) {
+        if (m_stream == nullptr || static_cast<std::size_t>(m_end - m_pos) >= bytes) {
+            return;
+        }
+        const std::size_t left = static_cast<std::size_t>(m_end - m_pos);
+        std::copy(m_pos, m_end, m_chunk.data());
+        m_pos = m_chunk.data();
+        m_end = m_pos + left;
+        while (static_cast<std::size_t>(m_end - m_pos) < bytes && *m_stream) {
+            m_stream->read(reinterpret_cast<char*>(m_chunk.data() + (m_end - m_pos)),
+                    static_cast<std::streamsize>(m_chunk.size() - static_cast<std::size_t>(m_end - m_pos)));
+            m_end += m_stream->gcount();
+        }
+        if (m_stream->bad()) {
+            m_status = decode_status::io_error;
+        }
+    }
+
+    void read_header() {
+        fill(detail::codec_header_size);
+        if (m_status != decode_status::ok) {
+            return;
+        }
+        const std::uint8_t* in = m_pos;
+        if (static_cast<std::size_t>(m_end - in) < 5 || !std::equal(in, in + 4, detail::codec_magic)
+                || in[4] != detail::codec_version) {
+            m_status = decode_status::bad_header;
+            return;
+        }
+        in += 5;
+
+        std::uint64_t bit_count = 0;
+        std::uint64_t words = 0;
+        if ((in = detail::read_varint(in, m_end, bit_count)) == nullptr
+                || (in = detail::read_varint(in, m_end, words)) == nullptr || m_end - in < 8) {
+            m_status = decode_status::bad_header;
+            return;
+        }
+        std::uint64_t fingerprint = 0;
+        for (unsigned i = 0; i < 8; ++i) {
+            fingerprint |= static_cast<std::uint64_t>(*in++) << (8 * i);
+        }
+        m_pos = in;
+        if (bit_count != FlagType::bit_count || words != traits::s_words
+                || fingerprint != detail::codec_fingerprint<FlagType>()) {
+            m_status = decode_status::type_mismatch;
+        }
+    }
+
+    // Decodes one record into m_previous / m_pending. Returns false at the end of the input or on error.
+    bool next_record() {
+        fill(detail::codec_max_record<FlagType>);
+        if (m_status != decode_status::ok) {
+            return false;
+        }
+        if (m_pos == m_end) {
+            m_status = decode_status::end;
+            return false;
+        }
+
+        const std::uint8_t* in = m_pos;
+        const std::uint8_t tag = *in++;
+        const std::uint8_t kind = tag & 3;
+        std::uint64_t argument = tag >> 2;
+        if (argument == detail::codec_inline_limit) {
+            if ((in = detail::read_varint(in, m_end, argument)) == nullptr) {
+                return corrupt();
+            }
+            argument += detail::codec_inline_limit;
+        }
+
+        switch (kind) {
+        case detail::codec_run:
+            m_pending = argument + 1;
+            break;
+        case detail::codec_flip: {
+            if (argument >= FlagType::bit_count) {
+                return corrupt();
+            }
+            std::uint64_t delta[traits::s_words] { };
+            delta[argument / 64] = std::uint64_t { 1 } << (argument % 64);
+            traits::apply(m_previous, delta);
+            break;
+        }
+        case detail::codec_literal: {
+            std::uint64_t delta[traits::s_words];
+            for (std::size_t i = 0; i < traits::s_words; ++i) {
+                if ((in = detail::read_varint(in, m_end, delta[i])) == nullptr) {
+                    return corrupt();
+                }
+            }
+            if (argument != 0 || !traits::apply(m_previous, delta)) {
+                return corrupt();
+            }
+            break;
+        }
+        default:
+            return corrupt();
+        }
+        m_pos = in;
+        return true;
+    }
+
+    bool corrupt() noexcept {
+        m_status = decode_status::corrupt;
+        return false;
+    }
+};
+
+}
+
+#endif /* INCLUDE_STRONG_FLAGS_CODEC_H_ */
@@ -0,0 +1,242 @@
+#ifndef INCLUDE_STRONG_FLAGS_CONSTRAINT_H_
+#define INCLUDE_STRONG_FLAGS_CONSTRAINT_H_
+
+#include "strong_flags.hpp"
+#include "bulk.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+// Declares the rules that values of `type` must follow, as a list of strong_flags::exclusive, implies and
+// one_of over its `_bit` constants. Use at global scope, after the type and before the first is_valid().
+#define STRONG_FLAGS_DEFINE_CONSTRAINTS(type, ...)                                                          \
+    template<> struct strong_flags::constraints<type> : ::strong_flags::constraint_list<type, __VA_ARGS__> {}
+
+namespace strong_flags {
+
+namespace detail {
+
+enum class constraint_kind {
+    at_most_one,
+    exactly_one,
+    implies
+};
+
+template<typename FlagType, std::size_t... Bits>
+constexpr FlagType constraint_mask() noexcept {
+    static_assert(((Bits < FlagType::bit_count) && ...), "Constraint bit out of range");
+    return (FlagType() | ... | FlagType::from_bit(Bits));
+}
+
+// Called when checked() meets an invalid value; not constexpr, so constant evaluation stops here.
+inline void constraint_violated() noexcept {
+}
+
+}
+
+// At most one of Bits is set.
+template<std::size_t... Bits>
+struct exclusive {
+    static_assert(sizeof...(Bits) >= 2, "exclusive needs at least two bits");
+
+    static constexpr detail::constraint_kind kind = detail::constraint_kind::at_most_one;
+
+    template<typename FlagType>
+    static constexpr FlagType mask() noexcept {
+        return detail::constraint_mask<FlagType, Bits...>();
+    }
+
+    template<typename FlagType>
+    static constexpr FlagType implied() noexcept {
+        return FlagType();
+    }
+};
+
+// Exactly one of Bits is set.
+template<std::size_t... Bits>
+struct one_of {
+    static_assert(sizeof...(Bits) >= 1, "one_of needs at least one bit");
+
+    static constexpr detail::constraint_kind kind = detail::constraint_kind::exactly_one;
+
+    template<typename FlagType>
+    static constexpr FlagType mask() noexcept {
+        return detail::constraint_mask<FlagType, Bits...>();
+    }
+
+    template<typename FlagType>
+    static constexpr FlagType implied() noexcept {
+        return FlagType();
+    }
+};
+
+// If bit If is set, all of Then are set.
+template<std::size_t If, std::size_t... Then>
+struct implies {
+    static_assert(sizeof...(Then) >= 1, "implies needs at least one implied bit");
+
+    static constexpr detail::constraint_kind kind = detail::constraint_kind::implies;
+
+    template<typename FlagType>
+    static constexpr FlagType mask() noexcept {
+        return detail::constraint_mask<FlagType, If>();
+    }
+
+    template<typename FlagType>
+    static constexpr FlagType implied() noexcept {
+        return detail::constraint_mask<FlagType, Then...>();
+    }
+};
+
+// Mask tables of a set of constraints, one entry per constraint.
+template<typename FlagType, typename... Constraints>
+struct constraint_list {
+    static constexpr std::size_t s_size = sizeof...(Constraints);
+    static constexpr detail::constraint_kind s_kinds[s_size + 1] = { Constraints::kind...,
+        detail::constraint_kind::at_most_one };
+    static constexpr FlagType s_masks[s_size + 1] = { Constraints::template mask<FlagType>()..., FlagType() };
+    static constexpr FlagType s_implied[s_size + 1] = { Constraints::template implied<FlagType>()..., FlagType() };
+};
+
+// Unconstrained unless specialized with STRONG_FLAGS_DEFINE_CONSTRAINTS.
+template<typename FlagType>
+struct constraints : constraint_list<FlagType> {
+};
+
+namespace detail {
+
+template<typename FlagType>
+constexpr bool constraint_holds(constraint_kind kind, const FlagType& mask, const FlagType& implied,
+        const FlagType& value) noexcept {
+    if constexpr (std::is_integral<typename FlagType::underlying_type>::value) {
+        using word_type = typename std::make_unsigned<typename FlagType::underlying_type>::type;
+        const auto v = static_cast<word_type>(value.to_underlying_type());
+        const auto x = static_cast<word_type>(v & static_cast<word_type>(mask.to_underlying_type()));
+        const auto i = static_cast<word_type>(implied.to_underlying_type());
+        const bool single = static_cast<word_type>(x & (x - 1)) == 0;
+        switch (kind) {
+        case constraint_kind::at_most_one:
+            return single;
+        case constraint_kind::exactly_one:
+            return single & (x != 0);
+        case constraint_kind::implies:
+            return (x == 0) | ((v & i) == i);
+        }
+        return false;
+    } else {
+        switch (kind) {
+        case constraint_kind::at_most_one:
+            return (value & mask).count() <= 1;
+        case constraint_kind::exactly_one:
+            return (value & mask).count() == 1;
+        case constraint_kind::implies:
+            return !value.test_any(mask) || value.test_all(implied);
+        }
+        return false;
+    }
+}
+
+// Evaluates every constraint without branching between them.
+template<typename List, typename FlagType, std::size_t... I>
+constexpr bool constraints_hold(const FlagType& value, std::index_sequence<I...>) noexcept {
+    return (true & ... & constraint_holds(List::s_kinds[I], List::s_masks[I], List::s_implied[I], value));
+}
+
+#if defined(STRONG_FLAGS_SIMD_AVX2) || defined(STRONG_FLAGS_SIMD_SSE2)
+// Lanes of `values` that satisfy one constraint, as all ones.
+template<typename T, typename FlagType>
+bulk_vector constraint_lane(constraint_kind kind, const FlagType& mask, const FlagType& implied,
+        bulk_vector values) noexcept {
+    using lanes = bulk_lanes<sizeof(T)>;
+    const bulk_vector zero { };
+    const bulk_vector x = bulk_and(values, lanes::broadcast(static_cast<T>(mask.to_underlying_type())));
+    switch (kind) {
+    case constraint_kind::at_most_one:
+    case constraint_kind::exactly_one: {
+        const bulk_vector single = lanes::equal(bulk_and(x, lanes::subtract(x, lanes::broadcast(1))), zero);
+        return kind == constraint_kind::at_most_one ? single : bulk_andnot(single, lanes::equal(x, zero));
+    }
+    case constraint_kind::implies: {
+        const bulk_vector i = lanes::broadcast(static_cast<T>(implied.to_underlying_type()));
+        return bulk_or(lanes::equal(x, zero), lanes::equal(bulk_and(values, i), i));
+    }
+    }
+    return zero;
+}
+
+template<typename T, typename List, std::size_t... I>
+bulk_vector constraint_lanes(bulk_vector values, std::index_sequence<I...>) noexcept {
+    bulk_vector res = bulk_lanes<sizeof(T)>::equal(values, values);
+    ((res = bulk_and(res, constraint_lane<T>(List::s_kinds[I], List::s_masks[I], List::s_implied[I], values))), ...);
+    return res;
+}
+#endif
+
+template<typename FlagType>
+std::size_t select_invalid(const FlagType* values, std::size_t count, std::size_t* indices) noexcept {
+    using list = constraints<FlagType>;
+    using sequence = std::make_index_sequence<list::s_size>;
+    if constexpr (list::s_size == 0) {
+        return 0;
+    }
+
+    std::size_t res = 0;
+    std::size_t i = 0;
+#if defined(STRONG_FLAGS_SIMD_AVX2) || defined(STRONG_FLAGS_SIMD_SSE2)
+    using traits = bulk_traits<FlagType>;
+    if constexpr (traits::s_raw) {
+        using T = typename traits::word_type;
+        using kernels = bulk_kernels<T>;
+        const T* data = traits::words(values);
+        for (; i + kernels::s_lanes <= count; i += kernels::s_lanes) {
+            const bulk_vector valid = constraint_lanes<T, list>(bulk_load(data + i), sequence { });
+            std::uint32_t bits = ~bulk_byte_mask(valid) & kernels::lane_pattern();
+            for (; bits != 0; bits &= bits - 1) {
+                indices[res++] = i + static_cast<std::size_t>(countr_zero(bits)) / sizeof(T);
+            }
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        if (!constraints_hold<list>(values[i], sequence { })) {
+            indices[res++] = i;
+        }
+    }
+    return res;
+}
+
+}
+
+// True if `value` satisfies every constraint declared for FlagType.
+template<typename FlagType>
+constexpr bool is_valid(const FlagType& value) noexcept {
+    using list = constraints<FlagType>;
+    return detail::constraints_hold<list>(value, std::make_index_sequence<list::s_size> { });
+}
+
+// Returns `value`. A constant initialized from an invalid value fails to compile:
+//   constexpr auto mode = strong_flags::checked(Mode::Read | Mode::Write);
+template<typename FlagType>
+constexpr FlagType checked(const FlagType& value) noexcept {
+    if (!is_valid(value)) {
+        detail::constraint_violated();
+    }
+    return value;
+}
+
+namespace bulk {
+
+// Writes the index of every element that breaks a constraint to `indices`, which must have room for
+// `count` entries. Returns the number of indices written.
+template<typename FlagType>
+std::size_t select_invalid(const FlagType* values, std::size_t count, std::size_t* indices) noexcept {
+    return detail::select_invalid(values, count, indices);
+}
+
+}
+
+}
+
+#endif /* INCLUDE_STRONG_FLAGS_CONSTRAINT_H_ */
@@ -0,0 +1,456 @@
+
+#ifndef INCLUDE_STRONG_FLAGS_DISPATCH_H_
+#define INCLUDE_STRONG_FLAGS_DISPATCH_H_
+
+#include "strong_flags.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace strong_flags {
+
+namespace detail {
+
+// Dispatch over at most this many distinct bits goes through a 2^bits jump table.
+constexpr std::size_t dispatch_table_bits = 8;
+
+enum class dispatch_kind {
+    any,
+    all,
+    otherwise,
+    bit
+};
+
+template<dispatch_kind Kind, typename Handler, std::size_t... Bits>
+struct dispatch_case {
+    static constexpr dispatch_kind kind = Kind;
+    static constexpr std::size_t bit_list[sizeof...(Bits) + 1] = { Bits..., 0 };
+    static constexpr std::size_t size = sizeof...(Bits);
+
+    Handler handler;
+};
+
+template<std::size_t Words>
+struct dispatch_mask {
+    std::uint64_t words[Words];
+
+    constexpr bool test(std::size_t bit) const noexcept {
+        return (words[bit / 64] >> (bit % 64) & 1) != 0;
+    }
+
+    constexpr void set(std::size_t bit) noexcept {
+        words[bit / 64] |= std::uint64_t { 1 } << (bit % 64);
+    }
+
+    constexpr bool intersects(const dispatch_mask& rhs) const noexcept {
+        for (std::size_t i = 0; i < Words; ++i) {
+            if ((words[i] & rhs.words[i]) != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    constexpr bool contains(const dispatch_mask& rhs) const noexcept {
+        for (std::size_t i = 0; i < Words; ++i) {
+            if ((words[i] & rhs.words[i]) != rhs.words[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+template<typename Handler, typename... Args>
+decltype(auto) dispatch_invoke(Handler& handler, const Args&... args) {
+    if constexpr (std::is_invocable<Handler&, const Args&...>::value) {
+        return handler(args...);
+    } else {
+        return handler();
+    }
+}
+
+template<typename Handler, typename... Args>
+using dispatch_result_t = decltype(dispatch_invoke(std::declval<Handler&>(), std::declval<const Args&>()...));
+
+// Compile-time view of a list of dispatch cases over N bits.
+template<std::size_t N, typename... Cases>
+struct dispatch_info {
+    static constexpr std::size_t count = sizeof...(Cases);
+    static constexpr std::size_t words = (N + 63) / 64;
+
+    using mask_type = dispatch_mask<words>;
+
+    mask_type masks[count + 1];
+    dispatch_kind kinds[count + 1];
+    bool bits_in_range;
+    mask_type used;
+    std::size_t used_count;
+    std::size_t positions[N + 1];
+    // Lowest when_any case mentioning each bit.
+    std::size_t first_case[N + 1];
+
+    constexpr dispatch_info() noexcept :
+            masks { }, kinds { Cases::kind..., dispatch_kind::otherwise }, bits_in_range { true }, used { },
+            used_count { 0 }, positions { }, first_case { } {
+        const std::size_t* lists[] = { Cases::bit_list..., nullptr };
+        const std::size_t sizes[] = { Cases::size..., 0 };
+        for (std::size_t c = 0; c < count; ++c) {
+            for (std::size_t i = 0; i < sizes[c]; ++i) {
+                if (lists[c][i] < N) {
+                    masks[c].set(lists[c][i]);
+                    used.set(lists[c][i]);
+                } else {
+                    bits_in_range = false;
+                }
+            }
+        }
+        for (std::size_t bit = 0; bit < N; ++bit) {
+            if (used.test(bit)) {
+                positions[used_count++] = bit;
+            }
+            first_case[bit] = count;
+            for (std::size_t c = count; c-- > 0;) {
+                if (kinds[c] == dispatch_kind::any && masks[c].test(bit)) {
+                    first_case[bit] = c;
+                }
+            }
+        }
+    }
+
+    constexpr bool has(dispatch_kind kind) const noexcept {
+        for (std::size_t c = 0; c < count; ++c) {
+            if (kinds[c] == kind) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    constexpr bool otherwise_last() const noexcept {
+        for (std::size_t c = 0; c + 1 < count; ++c) {
+            if (kinds[c] == dispatch_kind::otherwise) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    constexpr std::size_t otherwise_index() const noexcept {
+        return count > 0 && kinds[count - 1] == dispatch_kind::otherwise ? count - 1 : count;
+    }
+
+    // The used bits form one run inside a single word.
+    constexpr bool contiguous() const noexcept {
+        return used_count > 0 && positions[used_count - 1] - positions[0] + 1 == used_count
+                && positions[0] / 64 == positions[used_count - 1] / 64;
+    }
+
+    constexpr bool matches(std::size_t c, const mask_type& value) const noexcept {
+        return (kinds[c] == dispatch_kind::any && value.intersects(masks[c]))
+                || (kinds[c] == dispatch_kind::all && value.contains(masks[c]))
+                || kinds[c] == dispatch_kind::otherwise;
+    }
+
+    constexpr std::size_t first_match(const mask_type& value) const noexcept {
+        for (std::size_t c = 0; c < count; ++c) {
+            if (matches(c, value)) {
+                return c;
+            }
+        }
+        return count;
+    }
+
+    // Case c can be selected if its smallest matching value misses every earlier case: a single bit
+    // for when_any, exactly its bits for when_all. Adding bits only makes earlier cases match.
+    constexpr bool reachable(std::size_t c) const noexcept {
+        if (kinds[c] == dispatch_kind::any) {
+            for (std::size_t bit = 0; bit < N; ++bit) {
+                if (masks[c].test(bit)) {
+                    mask_type value { };
+                    value.set(bit);
+                    if (first_match(value) == c) {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+        return first_match(kinds[c] == dispatch_kind::all ? masks[c] : mask_type { }) == c;
+    }
+
+    constexpr bool all_reachable() const noexcept {
+        for (std::size_t c = 0; c < count; ++c) {
+            if (!reachable(c)) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+template<typename FlagType, typename... Cases>
+class dispatcher {
+public:
+    using flag_type = FlagType;
+    using bit_type = typename FlagType::bit_type;
+    using result_type = typename std::common_type<dispatch_result_t<decltype(Cases::handler), FlagType>...>::type;
+    using cases_type = std::tuple<Cases&...>;
+
+private:
+    static constexpr std::size_t N = FlagType::bit_count;
+    static constexpr dispatch_info<N, Cases...> s_info { };
+    static constexpr std::size_t s_count = sizeof...(Cases);
+    static constexpr bool s_table = s_info.used_count <= dispatch_table_bits;
+    static constexpr std::size_t s_table_size = s_table ? std::size_t { 1 } << s_info.used_count : 1;
+
+    using mask_type = typename dispatch_info<N, Cases...>::mask_type;
+    using function_type = result_type (*)(cases_type&, const FlagType&);
+
+    template<std::size_t C>
+    static result_type call(cases_type& cases, const FlagType& value) {
+        if constexpr (C == s_count) {
+            return result_type();
+        } else {
+            return static_cast<result_type>(dispatch_invoke(std::get<C>(cases).handler, value));
+        }
+    }
+
+    template<std::size_t... C>
+    static constexpr std::array<function_type, s_count + 1> functions(std::index_sequence<C...>) noexcept {
+        return { { &call<C>... } };
+    }
+
+    static constexpr std::array<function_type, s_table_size> make_table() noexcept {
+        const auto targets = functions(std::make_index_sequence<s_count + 1>());
+        std::array<function_type, s_table_size> res { };
+        for (std::size_t index = 0; index < s_table_size; ++index) {
+            mask_type value { };
+            for (std::size_t j = 0; j < s_info.used_count; ++j) {
+                if ((index >> j & 1) != 0) {
+                    value.set(s_info.positions[j]);
+                }
+            }
+            res[index] = targets[s_info.first_match(value)];
+        }
+        return res;
+    }
+
+    static constexpr FlagType make_flags(const mask_type& mask) noexcept {
+        FlagType res;
+        for (std::size_t bit = 0; bit < N; ++bit) {
+            if (mask.test(bit)) {
+                res = res | FlagType::from_bit(bit);
+            }
+        }
+        return res;
+    }
+
+    static std::uint64_t word(const FlagType& value, std::size_t index) noexcept {
+        using underlying_type = typename FlagType::underlying_type;
+        if constexpr (std::is_integral<underlying_type>::value) {
+            (void) index;
+            return static_cast<typename std::make_unsigned<underlying_type>::type>(value.to_underlying_type());
+        } else {
+            return value.to_underlying_type().word(index);
+        }
+    }
+
+    static std::size_t table_index(const FlagType& value) noexcept {
+        if constexpr (s_info.used_count == 0) {
+            return 0;
+        } else if constexpr (s_info.contiguous()) {
+            constexpr std::size_t first = s_info.positions[0];
+            return static_cast<std::size_t>(word(value, first / 64) >> (first % 64))
+                    & ((std::size_t { 1 } << s_info.used_count) - 1);
+        } else {
+            std::size_t res = 0;
+            for (std::size_t j = 0; j < s_info.used_count; ++j) {
+                const std::size_t bit = s_info.positions[j];
+                res |= static_cast<std::size_t>(word(value, bit / 64) >> (bit % 64) & 1) << j;
+            }
+            return res;
+        }
+    }
+
+    template<std::size_t C>
+    static result_type cascade(cases_type& cases, const FlagType& value) {
+        if constexpr (C == s_count) {
+            return result_type();
+        } else {
+            static constexpr FlagType mask = make_flags(s_info.masks[C]);
+            if ((s_info.kinds[C] == dispatch_kind::any && value.test_any(mask))
+                    || (s_info.kinds[C] == dispatch_kind::all && value.test_all(mask))
+                    || s_info.kinds[C] == dispatch_kind::otherwise) {
+                return call<C>(cases, value);
+            }
+            return cascade<C + 1>(cases, value);
+        }
+    }
+
+public:
+    static result_type run(cases_type& cases, const FlagType& value) {
+        static_assert(!s_info.has(dispatch_kind::bit), "dispatch takes when_any, when_all and otherwise cases");
+        static_assert(s_info.bits_in_range, "Dispatch case refers to a bit outside of the flag type");
+        static_assert(s_info.otherwise_last(), "otherwise must be the last dispatch case");
+        static_assert(s_info.all_reachable(), "Dispatch case is unreachable: earlier cases match all of its values");
+
+        if constexpr (s_table) {
+            static constexpr auto table = make_table();
+            return table[table_index(value)](cases, value);
+        } else if constexpr (!s_info.has(dispatch_kind::all)) {
+            static constexpr auto targets = functions(std::make_index_sequence<s_count + 1>());
+            static constexpr FlagType used = make_flags(s_info.used);
+            std::size_t best = s_info.otherwise_index();
+            for (bit_type bit : (value & used).bits()) {
+                if (s_info.first_case[bit] < best) {
+                    best = s_info.first_case[bit];
+                    if (best == 0) {
+                        break;
+                    }
+                }
+            }
+            return targets[best](cases, value);
+        } else {
+            return cascade<0>(cases, value);
+        }
+    }
+};
+
+template<typename FlagType, typename... Cases>
+class bit_dispatcher {
+public:
+    using bit_type = typename FlagType::bit_type;
+    using cases_type = std::tuple<Cases&...>;
+
+private:
+    static constexpr std::size_t N = FlagType::bit_count;
+    static constexpr std::size_t s_count = sizeof...(Cases);
+
+    static constexpr bool only_bit_cases() noexcept {
+        bool res = true;
+        for (bool bit_case : { true, (Cases::kind == dispatch_kind::bit)... }) {
+            res = res && bit_case;
+        }
+        return res;
+    }
+
+    static constexpr bool bits_in_range() noexcept {
+        bool res = true;
+        for (std::size_t bit : { std::size_t { 0 }, Cases::bit_list[0]... }) {
+            res = res && bit < N;
+        }
+        return res;
+    }
+
+    static constexpr bool no_overlap() noexcept {
+        const std::size_t bits[] = { N, Cases::bit_list[0]... };
+        for (std::size_t i = 1; i <= s_count; ++i) {
+            for (std::size_t j = 1; j < i; ++j) {
+                if (bits[i] == bits[j]) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    using function_type = void (*)(cases_type&, bit_type);
+
+    template<std::size_t C>
+    static void call(cases_type& cases, bit_type bit) {
+        dispatch_invoke(std::get<C>(cases).handler, bit);
+    }
+
+    template<std::size_t... C>
+    static constexpr std::array<function_type, N> make_table(std::index_sequence<C...>) noexcept {
+        std::array<function_type, N> res { };
+        const std::size_t bits[] = { N, Cases::bit_list[0]... };
+        const function_type functions[] = { nullptr, &call<C>... };
+        for (std::size_t i = 1; i <= s_count; ++i) {
+            res[bits[i]] = functions[i];
+        }
+        return res;
+    }
+
+    static constexpr FlagType make_handled() noexcept {
+        FlagType res;
+        for (std::size_t bit : { Cases::bit_list[0]... }) {
+            res = res | FlagType::from_bit(bit);
+        }
+        return res;
+    }
+
+public:
+    static void run(cases_type& cases, const FlagType& value) {
+        static_assert(only_bit_cases(), "dispatch_each takes on_bit cases");
+        static_assert(bits_in_range(), "Dispatch case refers to a bit outside of the flag type");
+        static_assert(no_overlap(), "Overlapping dispatch cases: more than one handler for the same bit");
+
+        static constexpr auto table = make_table(std::make_index_sequence<s_count>());
+        static constexpr FlagType handled = make_handled();
+        for (bit_type bit : (value & handled).bits()) {
+            table[bit](cases, bit);
+        }
+    }
+};
+
+}
+
+// Dispatch cases. Bits are the `_bit` constants generated by STRONG_FLAGS_DEFINE_FLAGS. Handlers are
+// called with the dispatched value if they accept it, otherwise without arguments.
+
+template<std::size_t... Bits, typename Handler>
+constexpr auto when_any(Handler&& handler) {
+    static_assert(sizeof...(Bits) > 0, "when_any needs at least one bit");
+    return detail::dispatch_case<detail::dispatch_kind::any, typename std::decay<Handler>::type, Bits...> {
+        std::forward<Handler>(handler) };
+}
+
+template<std::size_t... Bits, typename Handler>
+constexpr auto when_all(Handler&& handler) {
+    static_assert(sizeof...(Bits) > 0, "when_all needs at least one bit");
+    return detail::dispatch_case<detail::dispatch_kind::all, typename std::decay<Handler>::type, Bits...> {
+        std::forward<Handler>(handler) };
+}
+
+template<typename Handler>
+constexpr auto otherwise(Handler&& handler) {
+    return detail::dispatch_case<detail::dispatch_kind::otherwise, typename std::decay<Handler>::type> {
+        std::forward<Handler>(handler) };
+}
+
+// Handler for dispatch_each, called with the bit if it accepts it.
+template<std::size_t Bit, typename Handler>
+constexpr auto on_bit(Handler&& handler) {
+    return detail::dispatch_case<detail::dispatch_kind::bit, typename std::decay<Handler>::type, Bit> {
+        std::forward<Handler>(handler) };
+}
+
+// Calls the handler of the first case that matches `value`, like an if / else if chain over the
+// cases in order, and returns its result (a value-initialized result if nothing matches). When the
+// cases mention at most detail::dispatch_table_bits distinct bits this is a single indirect call
+// through a table over all their combinations. Otherwise cases without when_all resolve with one
+// pass over the set bits, and the rest test the cases in order.
+template<typename FlagType, typename... Cases>
+decltype(auto) dispatch(const FlagType& value, Cases&&... cases) {
+    using dispatcher = detail::dispatcher<FlagType, typename std::remove_reference<Cases>::type...>;
+    typename dispatcher::cases_type refs { cases... };
+    return dispatcher::run(refs, value);
+}
+
+// Calls the handler of every set bit of `value` that has one, in ascending bit order.
+template<typename FlagType, typename... Cases>
+void dispatch_each(const FlagType& value, Cases&&... cases) {
+    using dispatcher = detail::bit_dispatcher<FlagType, typename std::remove_reference<Cases>::type...>;
+    typename dispatcher::cases_type refs { cases... };
+    dispatcher::run(refs, value);
+}
+
+}
+
+#endif /* INCLUDE_STRONG_FLAGS_DISPATCH_H_ */
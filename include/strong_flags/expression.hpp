@@ -0,0 +1,325 @@
+#ifndef INCLUDE_STRONG_FLAGS_EXPRESSION_H_
+#define INCLUDE_STRONG_FLAGS_EXPRESSION_H_
+
+#include "strong_flags.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace strong_flags {
+
+namespace detail {
+
+struct flag_access {
+    template<typename FlagType>
+    static constexpr auto& value(FlagType& flags) noexcept {
+        return static_cast<typename FlagType::this_type&>(flags).m_value;
+    }
+
+    template<typename FlagType>
+    static constexpr const auto& mask() noexcept {
+        return FlagType::this_type::s_mask;
+    }
+};
+
+// Uniform word view of a flag value: one word for integer types, the 64 bit words of wide types.
+template<typename FlagType, bool = std::is_integral<typename FlagType::underlying_type>::value>
+struct expression_words {
+    using word_type = typename std::make_unsigned<typename FlagType::underlying_type>::type;
+
+    static constexpr std::size_t s_count = 1;
+
+    static constexpr word_type get(const FlagType& value, std::size_t) noexcept {
+        return static_cast<word_type>(value.to_underlying_type());
+    }
+
+    static constexpr word_type mask(std::size_t) noexcept {
+        return static_cast<word_type>(flag_access::mask<FlagType>());
+    }
+};
+
+template<typename FlagType>
+struct expression_words<FlagType, false> {
+    using word_type = std::uint64_t;
+
+    static constexpr std::size_t s_count = FlagType::underlying_type::word_count;
+
+    static constexpr word_type get(const FlagType& value, std::size_t i) noexcept {
+        return value.to_underlying_type().word(i);
+    }
+
+    static constexpr word_type mask(std::size_t i) noexcept {
+        return flag_access::mask<FlagType>().word(i);
+    }
+};
+
+struct expression_or {
+    template<typename Word>
+    static constexpr Word apply(Word lhs, Word rhs) noexcept {
+        return static_cast<Word>(lhs | rhs);
+    }
+};
+
+struct expression_and {
+    template<typename Word>
+    static constexpr Word apply(Word lhs, Word rhs) noexcept {
+        return static_cast<Word>(lhs & rhs);
+    }
+};
+
+struct expression_xor {
+    template<typename Word>
+    static constexpr Word apply(Word lhs, Word rhs) noexcept {
+        return static_cast<Word>(lhs ^ rhs);
+    }
+};
+
+}
+
+// Lazy flag expression. Combining operands builds a tree of these at compile time; converting it back to
+// FlagType computes every word of the result in a single pass, applying the mask once and only if the
+// tree contains a complement. Nodes refer to their leaf operands, so an expression must be evaluated
+// before those operands go away, normally within the full expression that builds it.
+template<typename Derived, typename FlagType>
+class expression {
+public:
+    using flag_type = FlagType;
+    using words = detail::expression_words<FlagType>;
+    using word_type = typename words::word_type;
+
+    constexpr FlagType eval() const noexcept {
+        static_assert(!Derived::s_array, "Expressions over arrays are evaluated with bulk::assign");
+        return eval_at(0);
+    }
+
+    constexpr operator FlagType() const noexcept {
+        return eval();
+    }
+
+    constexpr bool any() const noexcept {
+        static_assert(!Derived::s_array, "Expressions over arrays are evaluated with bulk::assign");
+        word_type acc = 0;
+        for (std::size_t i = 0; i < words::s_count; ++i) {
+            acc = static_cast<word_type>(acc | masked_word(0, i));
+        }
+        return acc != 0;
+    }
+
+    constexpr bool empty() const noexcept {
+        return !any();
+    }
+
+    // Value of the expression for one element of the arrays it reads.
+    constexpr FlagType eval_at(std::size_t element) const noexcept {
+        FlagType res;
+        auto& out = detail::flag_access::value(res);
+        if constexpr (std::is_integral<typename FlagType::underlying_type>::value) {
+            out = static_cast<typename FlagType::underlying_type>(masked_word(element, 0));
+        } else {
+            for (std::size_t i = 0; i < words::s_count; ++i) {
+                out.word(i) = masked_word(element, i);
+            }
+        }
+        return res;
+    }
+
+protected:
+    constexpr expression() noexcept = default;
+
+private:
+    constexpr const Derived& self() const noexcept {
+        return static_cast<const Derived&>(*this);
+    }
+
+    constexpr word_type masked_word(std::size_t element, std::size_t i) const noexcept {
+        if constexpr (Derived::s_complement) {
+            return static_cast<word_type>(self().word(element, i) & words::mask(i));
+        } else {
+            return self().word(element, i);
+        }
+    }
+};
+
+template<typename FlagType>
+class value_expression : public expression<value_expression<FlagType>, FlagType> {
+public:
+    using word_type = typename detail::expression_words<FlagType>::word_type;
+
+    static constexpr bool s_complement = false;
+    static constexpr bool s_array = false;
+
+    constexpr explicit value_expression(const FlagType& value) noexcept : m_value { value } {
+    }
+
+    constexpr word_type word(std::size_t, std::size_t i) const noexcept {
+        return detail::expression_words<FlagType>::get(m_value, i);
+    }
+
+    constexpr const FlagType& value() const noexcept {
+        return m_value;
+    }
+
+private:
+    const FlagType& m_value;
+};
+
+template<typename FlagType>
+class array_expression : public expression<array_expression<FlagType>, FlagType> {
+public:
+    using word_type = typename detail::expression_words<FlagType>::word_type;
+
+    static constexpr bool s_complement = false;
+    static constexpr bool s_array = true;
+
+    constexpr explicit array_expression(const FlagType* values) noexcept : m_values { values } {
+    }
+
+    constexpr word_type word(std::size_t element, std::size_t i) const noexcept {
+        return detail::expression_words<FlagType>::get(m_values[element], i);
+    }
+
+private:
+    const FlagType* m_values;
+};
+
+template<typename Op, typename Lhs, typename Rhs>
+class binary_expression : public expression<binary_expression<Op, Lhs, Rhs>, typename Lhs::flag_type> {
+public:
+    using word_type = typename Lhs::word_type;
+
+    static constexpr bool s_complement = Lhs::s_complement || Rhs::s_complement;
+    static constexpr bool s_array = Lhs::s_array || Rhs::s_array;
+
+    constexpr binary_expression(const Lhs& lhs, const Rhs& rhs) noexcept : m_lhs { lhs }, m_rhs { rhs } {
+    }
+
+    constexpr word_type word(std::size_t element, std::size_t i) const noexcept {
+        return Op::apply(m_lhs.word(element, i), m_rhs.word(element, i));
+    }
+
+    constexpr const Lhs& lhs() const noexcept {
+        return m_lhs;
+    }
+
+    constexpr const Rhs& rhs() const noexcept {
+        return m_rhs;
+    }
+
+private:
+    Lhs m_lhs;
+    Rhs m_rhs;
+
+    static_assert(std::is_same<typename Lhs::flag_type, typename Rhs::flag_type>::value,
+            "Expression operands must have the same flag type");
+};
+
+template<typename Operand>
+class not_expression : public expression<not_expression<Operand>, typename Operand::flag_type> {
+public:
+    using word_type = typename Operand::word_type;
+
+    static constexpr bool s_complement = true;
+    static constexpr bool s_array = Operand::s_array;
+
+    constexpr explicit not_expression(const Operand& operand) noexcept : m_operand { operand } {
+    }
+
+    constexpr word_type word(std::size_t element, std::size_t i) const noexcept {
+        return static_cast<word_type>(~m_operand.word(element, i));
+    }
+
+    constexpr const Operand& operand() const noexcept {
+        return m_operand;
+    }
+
+private:
+    Operand m_operand;
+};
+
+// Opts a value into lazy evaluation: lazy(a) & ~b | c builds an expression instead of temporaries.
+template<typename FlagType>
+constexpr value_expression<FlagType> lazy(const FlagType& value) noexcept {
+    return value_expression<FlagType> { value };
+}
+
+// Element-wise operand for bulk::assign.
+template<typename FlagType>
+constexpr array_expression<FlagType> lazy_array(const FlagType* values) noexcept {
+    return array_expression<FlagType> { values };
+}
+
+template<typename Lhs, typename Rhs, typename FlagType>
+constexpr binary_expression<detail::expression_or, Lhs, Rhs> operator|(const expression<Lhs, FlagType>& lhs,
+        const expression<Rhs, FlagType>& rhs) noexcept {
+    return { static_cast<const Lhs&>(lhs), static_cast<const Rhs&>(rhs) };
+}
+
+template<typename Lhs, typename FlagType>
+constexpr binary_expression<detail::expression_or, Lhs, value_expression<FlagType>> operator|(
+        const expression<Lhs, FlagType>& lhs, const FlagType& rhs) noexcept {
+    return { static_cast<const Lhs&>(lhs), value_expression<FlagType> { rhs } };
+}
+
+template<typename Rhs, typename FlagType>
+constexpr binary_expression<detail::expression_or, value_expression<FlagType>, Rhs> operator|(const FlagType& lhs,
+        const expression<Rhs, FlagType>& rhs) noexcept {
+    return { value_expression<FlagType> { lhs }, static_cast<const Rhs&>(rhs) };
+}
+
+template<typename Lhs, typename Rhs, typename FlagType>
+constexpr binary_expression<detail::expression_and, Lhs, Rhs> operator&(const expression<Lhs, FlagType>& lhs,
+        const expression<Rhs, FlagType>& rhs) noexcept {
+    return { static_cast<const Lhs&>(lhs), static_cast<const Rhs&>(rhs) };
+}
+
+template<typename Lhs, typename FlagType>
+constexpr binary_expression<detail::expression_and, Lhs, value_expression<FlagType>> operator&(
+        const expression<Lhs, FlagType>& lhs, const FlagType& rhs) noexcept {
+    return { static_cast<const Lhs&>(lhs), value_expression<FlagType> { rhs } };
+}
+
+template<typename Rhs, typename FlagType>
+constexpr binary_expression<detail::expression_and, value_expression<FlagType>, Rhs> operator&(const FlagType& lhs,
+        const expression<Rhs, FlagType>& rhs) noexcept {
+    return { value_expression<FlagType> { lhs }, static_cast<const Rhs&>(rhs) };
+}
+
+template<typename Lhs, typename Rhs, typename FlagType>
+constexpr binary_expression<detail::expression_xor, Lhs, Rhs> operator^(const expression<Lhs, FlagType>& lhs,
+        const expression<Rhs, FlagType>& rhs) noexcept {
+    return { static_cast<const Lhs&>(lhs), static_cast<const Rhs&>(rhs) };
+}
+
+template<typename Lhs, typename FlagType>
+constexpr binary_expression<detail::expression_xor, Lhs, value_expression<FlagType>> operator^(
+        const expression<Lhs, FlagType>& lhs, const FlagType& rhs) noexcept {
+    return { static_cast<const Lhs&>(lhs), value_expression<FlagType> { rhs } };
+}
+
+template<typename Rhs, typename FlagType>
+constexpr binary_expression<detail::expression_xor, value_expression<FlagType>, Rhs> operator^(const FlagType& lhs,
+        const expression<Rhs, FlagType>& rhs) noexcept {
+    return { value_expression<FlagType> { lhs }, static_cast<const Rhs&>(rhs) };
+}
+
+template<typename Operand, typename FlagType>
+constexpr not_expression<Operand> operator~(const expression<Operand, FlagType>& operand) noexcept {
+    return not_expression<Operand> { static_cast<const Operand&>(operand) };
+}
+
+namespace bulk {
+
+// dst[i] = expression evaluated at element i, in one pass; dst may be one of the expression's arrays.
+template<typename FlagType, typename Derived>
+void assign(FlagType* dst, std::size_t count, const expression<Derived, FlagType>& expr) noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+        dst[i] = expr.eval_at(i);
+    }
+}
+
+}
+
+}
+
+#endif /* INCLUDE_STRONG_FLAGS_EXPRESSION_H_ */
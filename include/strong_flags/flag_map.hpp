@@ -0,0 +1,563 @@
+#ifndef INCLUDE_STRONG_FLAGS_FLAG_MAP_H_
+#define INCLUDE_STRONG_FLAGS_FLAG_MAP_H_
+
+#include "format.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace strong_flags {
+
+namespace detail {
+
+template<typename Unsigned>
+constexpr std::size_t hash_word(Unsigned value) noexcept {
+    return static_cast<std::size_t>(name_mix(static_cast<std::uint64_t>(value)));
+}
+
+template<std::size_t N>
+constexpr std::size_t hash_word(const wide_bitset<N>& value) noexcept {
+    std::uint64_t res = 0;
+    for (std::size_t i = 0; i < wide_bitset<N>::word_count; ++i) {
+        res = name_mix(res ^ value.word(i));
+    }
+    return static_cast<std::size_t>(res);
+}
+
+// Orders values by their numeric value, the most significant word deciding for wide types.
+template<typename FlagType>
+constexpr bool flag_less(const FlagType& lhs, const FlagType& rhs) noexcept {
+    using underlying_type = typename FlagType::underlying_type;
+    if constexpr (std::is_integral<underlying_type>::value) {
+        using unsigned_type = typename std::make_unsigned<underlying_type>::type;
+        return static_cast<unsigned_type>(lhs.to_underlying_type())
+                < static_cast<unsigned_type>(rhs.to_underlying_type());
+    } else {
+        for (std::size_t i = underlying_type::word_count; i-- > 0;) {
+            const auto a = lhs.to_underlying_type().word(i);
+            const auto b = rhs.to_underlying_type().word(i);
+            if (a != b) {
+                return a < b;
+            }
+        }
+        return false;
+    }
+}
+
+}
+
+// Mixes the bits of the value, so the result also suits power of two tables.
+template<typename FlagType>
+struct hash {
+    constexpr std::size_t operator()(const FlagType& value) const noexcept {
+        return detail::hash_word(value.to_underlying_type());
+    }
+};
+
+}
+
+namespace std {
+
+template<std::size_t N>
+struct hash<::strong_flags::wide_bitset<N>> {
+    std::size_t operator()(const ::strong_flags::wide_bitset<N>& value) const noexcept {
+        return ::strong_flags::detail::hash_word(value);
+    }
+};
+
+}
+
+// std::hash of a specific flag type, e.g. STRONG_FLAGS_DEFINE_HASH(Color::type). Flag types derive from
+// impl, and a std::hash specialization for a base class is never picked for a derived key, so each type
+// that is used with std::unordered_map needs this line. The standard only allows the specialization at
+// global scope, so it cannot come out of STRONG_FLAGS_DEFINE_FLAGS.
+#define STRONG_FLAGS_DEFINE_HASH(flag_type)                                                                 \
+    template<>                                                                                              \
+    struct std::hash<flag_type> : ::strong_flags::hash<flag_type> {                                         \
+    }
+
+namespace strong_flags {
+
+// Flag types up to this many flags are keyed by direct indexing.
+constexpr std::size_t flag_map_dense_bits = 16;
+
+template<typename FlagType, typename Value>
+struct flag_map_entry {
+    FlagType key;
+    Value& value;
+};
+
+namespace detail {
+
+template<typename FlagType>
+constexpr bool flag_map_is_dense = std::is_integral<typename FlagType::underlying_type>::value
+        && FlagType::bit_count <= flag_map_dense_bits;
+
+// One slot per possible value, indexed by the value itself; a bitmap marks the occupied ones.
+template<typename FlagType, typename Value>
+class flag_map_dense {
+public:
+    using key_type = FlagType;
+    using mapped_type = Value;
+    using size_type = std::size_t;
+
+    template<typename Map, typename Mapped>
+    class basic_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = flag_map_entry<FlagType, Mapped>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        constexpr basic_iterator() noexcept : m_map { }, m_slot { s_slots } {
+        }
+
+        constexpr basic_iterator(Map* map, size_type slot) noexcept : m_map { map }, m_slot { slot } {
+            skip_empty();
+        }
+
+        constexpr reference operator*() const noexcept {
+            return reference { slot_key(m_slot), m_map->m_values[m_slot] };
+        }
+
+        constexpr basic_iterator& operator++() noexcept {
+            ++m_slot;
+            skip_empty();
+            return *this;
+        }
+
+        constexpr basic_iterator operator++(int) noexcept {
+            auto res = *this;
+            ++*this;
+            return res;
+        }
+
+        constexpr bool operator==(const basic_iterator& rhs) const noexcept {
+            return m_slot == rhs.m_slot;
+        }
+
+        constexpr bool operator!=(const basic_iterator& rhs) const noexcept {
+            return m_slot != rhs.m_slot;
+        }
+
+    private:
+        Map* m_map;
+        size_type m_slot;
+
+        constexpr void skip_empty() noexcept {
+            while (m_slot < s_slots) {
+                const auto bits = m_map->m_used[m_slot / 64] >> (m_slot % 64);
+                if (bits != 0) {
+                    m_slot += static_cast<size_type>(countr_zero(bits));
+                    return;
+                }
+                m_slot = (m_slot / 64 + 1) * 64;
+            }
+            m_slot = s_slots;
+        }
+    };
+
+    using iterator = basic_iterator<flag_map_dense, Value>;
+    using const_iterator = basic_iterator<const flag_map_dense, const Value>;
+
+    constexpr flag_map_dense() noexcept(std::is_nothrow_default_constructible<Value>::value)
+            : m_values { }, m_used { }, m_size { 0 } {
+    }
+
+    constexpr flag_map_dense(std::initializer_list<std::pair<FlagType, Value>> init) : flag_map_dense() {
+        for (const auto& item : init) {
+            insert_or_assign(item.first, item.second);
+        }
+    }
+
+    constexpr Value* find(const FlagType& key) noexcept {
+        const auto s = slot(key);
+        return used(s) ? &m_values[s] : nullptr;
+    }
+
+    constexpr const Value* find(const FlagType& key) const noexcept {
+        const auto s = slot(key);
+        return used(s) ? &m_values[s] : nullptr;
+    }
+
+    constexpr bool contains(const FlagType& key) const noexcept {
+        return used(slot(key));
+    }
+
+    // Returns false, leaving the stored value alone, if the key is already present.
+    constexpr bool insert(const FlagType& key, const Value& value) {
+        const auto s = slot(key);
+        if (used(s)) {
+            return false;
+        }
+        mark(s);
+        m_values[s] = value;
+        return true;
+    }
+
+    // Returns true if the key was not present before.
+    constexpr bool insert_or_assign(const FlagType& key, const Value& value) {
+        const auto s = slot(key);
+        const bool res = !used(s);
+        if (res) {
+            mark(s);
+        }
+        m_values[s] = value;
+        return res;
+    }
+
+    constexpr Value& operator[](const FlagType& key) {
+        const auto s = slot(key);
+        if (!used(s)) {
+            mark(s);
+            m_values[s] = Value { };
+        }
+        return m_values[s];
+    }
+
+    constexpr bool erase(const FlagType& key) {
+        const auto s = slot(key);
+        if (!used(s)) {
+            return false;
+        }
+        m_used[s / 64] &= ~(std::uint64_t { 1 } << (s % 64));
+        m_values[s] = Value { };
+        --m_size;
+        return true;
+    }
+
+    constexpr void clear() {
+        for (size_type s = 0; s < s_slots; ++s) {
+            if (used(s)) {
+                m_values[s] = Value { };
+            }
+        }
+        m_used = { };
+        m_size = 0;
+    }
+
+    constexpr size_type size() const noexcept {
+        return m_size;
+    }
+
+    constexpr bool empty() const noexcept {
+        return m_size == 0;
+    }
+
+    constexpr iterator begin() noexcept {
+        return iterator { this, 0 };
+    }
+
+    constexpr iterator end() noexcept {
+        return iterator { this, s_slots };
+    }
+
+    constexpr const_iterator begin() const noexcept {
+        return const_iterator { this, 0 };
+    }
+
+    constexpr const_iterator end() const noexcept {
+        return const_iterator { this, s_slots };
+    }
+
+private:
+    using unsigned_type = typename std::make_unsigned<typename FlagType::underlying_type>::type;
+
+    static constexpr size_type s_slots = size_type { 1 } << FlagType::bit_count;
+    static constexpr size_type s_used_words = (s_slots + 63) / 64;
+
+    std::array<Value, s_slots> m_values;
+    std::array<std::uint64_t, s_used_words> m_used;
+    size_type m_size;
+
+    static constexpr size_type slot(const FlagType& key) noexcept {
+        return static_cast<size_type>(static_cast<unsigned_type>(key.to_underlying_type()));
+    }
+
+    static constexpr FlagType slot_key(size_type slot) noexcept {
+        return FlagType::from_underlying_type(static_cast<typename FlagType::underlying_type>(slot));
+    }
+
+    constexpr bool used(size_type s) const noexcept {
+        return (m_used[s / 64] >> (s % 64)) & 1;
+    }
+
+    constexpr void mark(size_type s) noexcept {
+        m_used[s / 64] |= std::uint64_t { 1 } << (s % 64);
+        ++m_size;
+    }
+
+    static_assert(std::is_default_constructible<Value>::value, "Dense flag_map values must be default constructible");
+};
+
+// Linear probing over a power of two table kept at most half full, with backward shift deletion so
+// lookups never step over tombstones. Iteration walks (key, slot) pairs sorted by key; the first
+// iteration after an insert or erase rebuilds them, which is why there is no const begin().
+template<typename FlagType, typename Value>
+class flag_map_hashed {
+public:
+    using key_type = FlagType;
+    using mapped_type = Value;
+    using size_type = std::size_t;
+
+    template<typename Map, typename Mapped>
+    class basic_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = flag_map_entry<FlagType, Mapped>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        basic_iterator() noexcept : m_map { }, m_index { 0 } {
+        }
+
+        basic_iterator(Map* map, size_type index) noexcept : m_map { map }, m_index { index } {
+        }
+
+        reference operator*() const noexcept {
+            const auto& entry = m_map->m_order[m_index];
+            return reference { entry.first, m_map->m_values[entry.second] };
+        }
+
+        basic_iterator& operator++() noexcept {
+            ++m_index;
+            return *this;
+        }
+
+        basic_iterator operator++(int) noexcept {
+            auto res = *this;
+            ++*this;
+            return res;
+        }
+
+        bool operator==(const basic_iterator& rhs) const noexcept {
+            return m_index == rhs.m_index;
+        }
+
+        bool operator!=(const basic_iterator& rhs) const noexcept {
+            return m_index != rhs.m_index;
+        }
+
+    private:
+        Map* m_map;
+        size_type m_index;
+    };
+
+    using iterator = basic_iterator<flag_map_hashed, Value>;
+
+    flag_map_hashed() = default;
+
+    flag_map_hashed(std::initializer_list<std::pair<FlagType, Value>> init) {
+        reserve(init.size());
+        for (const auto& item : init) {
+            insert_or_assign(item.first, item.second);
+        }
+    }
+
+    Value* find(const FlagType& key) noexcept {
+        const auto s = find_slot(key);
+        return s != s_none ? &m_values[s] : nullptr;
+    }
+
+    const Value* find(const FlagType& key) const noexcept {
+        const auto s = find_slot(key);
+        return s != s_none ? &m_values[s] : nullptr;
+    }
+
+    bool contains(const FlagType& key) const noexcept {
+        return find_slot(key) != s_none;
+    }
+
+    bool insert(const FlagType& key, const Value& value) {
+        if (contains(key)) {
+            return false;
+        }
+        m_values[add(key)] = value;
+        return true;
+    }
+
+    bool insert_or_assign(const FlagType& key, const Value& value) {
+        if (auto* existing = find(key)) {
+            *existing = value;
+            return false;
+        }
+        m_values[add(key)] = value;
+        return true;
+    }
+
+    Value& operator[](const FlagType& key) {
+        const auto s = find_slot(key);
+        return s != s_none ? m_values[s] : m_values[add(key)];
+    }
+
+    bool erase(const FlagType& key) {
+        auto hole = find_slot(key);
+        if (hole == s_none) {
+            return false;
+        }
+        --m_size;
+        m_order_dirty = true;
+
+        // Pulls later members of the probe run back into the hole, unless that would move them in
+        // front of their home slot.
+        const size_type mask = m_used.size() - 1;
+        for (size_type s = (hole + 1) & mask; m_used[s]; s = (s + 1) & mask) {
+            const size_type home = hash<FlagType> { }(m_keys[s]) & mask;
+            if (((s - home) & mask) >= ((s - hole) & mask)) {
+                m_keys[hole] = m_keys[s];
+                m_values[hole] = std::move(m_values[s]);
+                hole = s;
+            }
+        }
+        m_used[hole] = 0;
+        m_keys[hole] = FlagType { };
+        m_values[hole] = Value { };
+        return true;
+    }
+
+    void clear() {
+        m_keys.clear();
+        m_values.clear();
+        m_used.clear();
+        m_size = 0;
+        m_order.clear();
+        m_order_dirty = false;
+    }
+
+    void reserve(size_type count) {
+        size_type capacity = 16;
+        while (capacity < 2 * count) {
+            capacity *= 2;
+        }
+        if (capacity > m_used.size()) {
+            rehash(capacity);
+        }
+    }
+
+    size_type size() const noexcept {
+        return m_size;
+    }
+
+    bool empty() const noexcept {
+        return m_size == 0;
+    }
+
+    iterator begin() {
+        sort_order();
+        return iterator { this, 0 };
+    }
+
+    iterator end() noexcept {
+        return iterator { this, m_size };
+    }
+
+private:
+    static constexpr size_type s_none = ~size_type { 0 };
+
+    std::vector<FlagType> m_keys;
+    std::vector<Value> m_values;
+    std::vector<std::uint8_t> m_used;
+    size_type m_size = 0;
+    std::vector<std::pair<FlagType, size_type>> m_order;
+    bool m_order_dirty = false;
+
+    size_type find_slot(const FlagType& key) const noexcept {
+        if (m_used.empty()) {
+            return s_none;
+        }
+        const size_type mask = m_used.size() - 1;
+        for (size_type s = hash<FlagType> { }(key) & mask; m_used[s]; s = (s + 1) & mask) {
+            if (m_keys[s] == key) {
+                return s;
+            }
+        }
+        return s_none;
+    }
+
+    // Claims a slot for a key known to be absent.
+    size_type add(const FlagType& key) {
+        reserve(m_size + 1);
+        const size_type mask = m_used.size() - 1;
+        size_type s = hash<FlagType> { }(key) & mask;
+        while (m_used[s]) {
+            s = (s + 1) & mask;
+        }
+        m_used[s] = 1;
+        m_keys[s] = key;
+        ++m_size;
+        m_order_dirty = true;
+        return s;
+    }
+
+    void sort_order() {
+        if (!m_order_dirty) {
+            return;
+        }
+        m_order.clear();
+        m_order.reserve(m_size);
+        for (size_type s = 0; s < m_used.size(); ++s) {
+            if (m_used[s]) {
+                m_order.emplace_back(m_keys[s], s);
+            }
+        }
+        std::sort(m_order.begin(), m_order.end(), [](const auto& lhs, const auto& rhs) {
+            return flag_less(lhs.first, rhs.first);
+        });
+        m_order_dirty = false;
+    }
+
+    void rehash(size_type capacity) {
+        std::vector<FlagType> keys(capacity);
+        std::vector<Value> values(capacity);
+        std::vector<std::uint8_t> used(capacity);
+        const size_type mask = capacity - 1;
+        for (size_type i = 0; i < m_used.size(); ++i) {
+            if (m_used[i]) {
+                size_type s = hash<FlagType> { }(m_keys[i]) & mask;
+                while (used[s]) {
+                    s = (s + 1) & mask;
+                }
+                used[s] = 1;
+                keys[s] = m_keys[i];
+                values[s] = std::move(m_values[i]);
+            }
+        }
+        m_keys.swap(keys);
+        m_values.swap(values);
+        m_used.swap(used);
+        m_order_dirty = true;
+    }
+};
+
+}
+
+// Map keyed by flag values. Types with at most flag_map_dense_bits flags use a flat array indexed by
+// the value, which is constexpr and needs neither hashing nor probing; wider types use an open
+// addressing table. Both iterate in increasing key order, yielding { key, value } entries; the hashed
+// table sorts on the first iteration after a change, so it is only iterable through a non-const map.
+template<typename FlagType, typename Value>
+class flag_map : public std::conditional<detail::flag_map_is_dense<FlagType>,
+        detail::flag_map_dense<FlagType, Value>, detail::flag_map_hashed<FlagType, Value>>::type {
+private:
+    using base_type = typename std::conditional<detail::flag_map_is_dense<FlagType>,
+            detail::flag_map_dense<FlagType, Value>, detail::flag_map_hashed<FlagType, Value>>::type;
+
+public:
+    using base_type::base_type;
+
+    static constexpr bool is_dense = detail::flag_map_is_dense<FlagType>;
+};
+
+}
+
+#endif /* INCLUDE_STRONG_FLAGS_FLAG_MAP_H_ */
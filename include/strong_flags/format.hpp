@@ -0,0 +1,214 @@
+
+#ifndef INCLUDE_STRONG_FLAGS_FORMAT_H_
+#define INCLUDE_STRONG_FLAGS_FORMAT_H_
+
+#include "strong_flags.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace strong_flags {
+
+namespace detail {
+
+constexpr std::uint64_t name_hash(std::string_view name) noexcept {
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for (char c : name) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+constexpr std::uint64_t name_mix(std::uint64_t value) noexcept {
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+constexpr std::size_t ceil_log2(std::size_t value) noexcept {
+    std::size_t res = 0;
+    while ((std::size_t { 1 } << res) < value) {
+        ++res;
+    }
+    return res;
+}
+
+inline void perfect_hash_not_found() noexcept {
+}
+
+// Hash-and-displace perfect hash over a name table, built during constant evaluation. Each name
+// falls into a bucket, every bucket gets a displacement that sends all of its names to free slots,
+// so a lookup is one hash of the input, one slot read and a single string compare.
+template<std::size_t N>
+class perfect_hash {
+public:
+    constexpr explicit perfect_hash(const name_table<N>& names) noexcept : m_displacements { }, m_slots { } {
+        for (auto& slot : m_slots) {
+            slot = s_empty;
+        }
+
+        std::uint64_t hashes[N] { };
+        std::size_t bucket_sizes[s_buckets] { };
+        std::size_t largest = 0;
+        for (std::size_t i = 0; i < N; ++i) {
+            hashes[i] = name_hash(names[i]);
+            const auto size = ++bucket_sizes[bucket(hashes[i])];
+            largest = size > largest ? size : largest;
+        }
+
+        for (std::size_t size = largest; size > 0; --size) {
+            for (std::size_t b = 0; b < s_buckets; ++b) {
+                if (bucket_sizes[b] == size) {
+                    place(b, hashes);
+                }
+            }
+        }
+    }
+
+    // Returns N if `name` is not in the table.
+    constexpr std::size_t find(std::string_view name, const name_table<N>& names) const noexcept {
+        const auto hash = name_hash(name);
+        const auto bit = m_slots[slot(hash, m_displacements[bucket(hash)])];
+        return bit != s_empty && names[bit] == name ? bit : N;
+    }
+
+private:
+    static constexpr std::size_t s_slot_bits = ceil_log2(2 * N);
+    static constexpr std::size_t s_buckets = std::size_t { 1 } << ceil_log2(N / 2 + 1);
+    static constexpr std::uint16_t s_empty = 0xFFFF;
+    static constexpr std::uint32_t s_max_displacement = 1U << 20;
+
+    std::uint32_t m_displacements[s_buckets];
+    std::uint16_t m_slots[std::size_t { 1 } << s_slot_bits];
+
+    static constexpr std::size_t bucket(std::uint64_t hash) noexcept {
+        return static_cast<std::size_t>(hash & (s_buckets - 1));
+    }
+
+    static constexpr std::size_t slot(std::uint64_t hash, std::uint32_t displacement) noexcept {
+        if constexpr (s_slot_bits == 0) {
+            return 0;
+        } else {
+            const auto mixed = name_mix(hash + displacement * 0x9e3779b97f4a7c15ULL);
+            return static_cast<std::size_t>(mixed >> (64 - s_slot_bits));
+        }
+    }
+
+    constexpr void place(std::size_t b, const std::uint64_t (&hashes)[N]) noexcept {
+        std::size_t members[N] { };
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < N; ++i) {
+            if (bucket(hashes[i]) == b) {
+                members[count++] = i;
+            }
+        }
+
+        for (std::uint32_t displacement = 0; displacement < s_max_displacement; ++displacement) {
+            bool fits = true;
+            for (std::size_t k = 0; k < count && fits; ++k) {
+                const auto target = slot(hashes[members[k]], displacement);
+                fits = m_slots[target] == s_empty;
+                for (std::size_t j = 0; j < k && fits; ++j) {
+                    fits = slot(hashes[members[j]], displacement) != target;
+                }
+            }
+            if (fits) {
+                m_displacements[b] = displacement;
+                for (std::size_t k = 0; k < count; ++k) {
+                    m_slots[slot(hashes[members[k]], displacement)] = static_cast<std::uint16_t>(members[k]);
+                }
+                return;
+            }
+        }
+        // Only reachable if two names share a full 64 bit hash; makes the constant evaluation fail.
+        perfect_hash_not_found();
+    }
+
+    static_assert(N < s_empty, "Too many flags for the name hash");
+};
+
+// Instantiated only for types that are actually parsed, so defining flags stays cheap.
+template<typename FlagType>
+struct name_index {
+    static constexpr perfect_hash<FlagType::bit_count> s_hash { FlagType::names };
+};
+
+constexpr std::string_view trim_spaces(std::string_view text) noexcept {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+}
+
+template<typename FlagType>
+constexpr std::string_view name_of(typename FlagType::bit_type bit) noexcept {
+    return bit < FlagType::bit_count ? FlagType::names[bit] : std::string_view { };
+}
+
+// Returns FlagType::bit_count if `name` is not a flag of FlagType.
+template<typename FlagType>
+constexpr typename FlagType::bit_type find_bit(std::string_view name) noexcept {
+    return detail::name_index<FlagType>::s_hash.find(name, FlagType::names);
+}
+
+// Writes the names of the set flags joined by `separator`, with snprintf semantics: at most
+// capacity - 1 characters followed by a terminating zero. Returns the length of the full text.
+template<typename FlagType>
+std::size_t format_to(char* buffer, std::size_t capacity, const FlagType& flags,
+        std::string_view separator = "|") noexcept {
+    std::size_t length = 0;
+    const auto append = [&](std::string_view text) {
+        for (char c : text) {
+            if (length + 1 < capacity) {
+                buffer[length] = c;
+            }
+            ++length;
+        }
+    };
+
+    bool first = true;
+    for (auto bit : flags.bits()) {
+        if (!first) {
+            append(separator);
+        }
+        append(FlagType::names[bit]);
+        first = false;
+    }
+    if (capacity != 0) {
+        buffer[length < capacity ? length : capacity - 1] = '\0';
+    }
+    return length;
+}
+
+// Parses names joined by `separator`, ignoring surrounding blanks. An empty text yields no flags;
+// an unknown or empty name yields std::nullopt.
+template<typename FlagType>
+constexpr std::optional<FlagType> parse(std::string_view text, std::string_view separator = "|") noexcept {
+    FlagType res;
+    if (detail::trim_spaces(text).empty()) {
+        return res;
+    }
+    while (true) {
+        const auto end = separator.empty() ? std::string_view::npos : text.find(separator);
+        const auto bit = find_bit<FlagType>(detail::trim_spaces(text.substr(0, end)));
+        if (bit == FlagType::bit_count) {
+            return std::nullopt;
+        }
+        res = res | FlagType::from_bit(bit);
+        if (end == std::string_view::npos) {
+            return res;
+        }
+        text.remove_prefix(end + separator.size());
+    }
+}
+
+}
+
+#endif /* INCLUDE_STRONG_FLAGS_FORMAT_H_ */
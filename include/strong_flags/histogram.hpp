@@ -0,0 +1,328 @@
+
+#ifndef INCLUDE_STRONG_FLAGS_HISTOGRAM_H_
+#define INCLUDE_STRONG_FLAGS_HISTOGRAM_H_
+
+#include "bulk.hpp"
+#include "format.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace strong_flags {
+
+namespace detail {
+
+struct histogram_scalar_ops {
+    using vector = std::uint64_t;
+
+    static constexpr std::size_t bytes = sizeof(vector);
+
+    static vector load(const std::uint8_t* src) noexcept {
+        vector res;
+        std::memcpy(&res, src, sizeof(res));
+        return res;
+    }
+
+    static void store(std::uint8_t* dst, vector value) noexcept {
+        std::memcpy(dst, &value, sizeof(value));
+    }
+
+    static vector bit_xor(vector lhs, vector rhs) noexcept {
+        return lhs ^ rhs;
+    }
+
+    static vector bit_and(vector lhs, vector rhs) noexcept {
+        return lhs & rhs;
+    }
+
+    static vector bit_or(vector lhs, vector rhs) noexcept {
+        return lhs | rhs;
+    }
+
+    // Bit k of every byte, moved to the low bit of the byte.
+    static vector byte_bit(vector value, int k) noexcept {
+        return (value >> k) & 0x0101010101010101ULL;
+    }
+
+    // Lane-wise byte addition; callers keep every lane below 256.
+    static vector add_bytes(vector lhs, vector rhs) noexcept {
+        return lhs + rhs;
+    }
+};
+
+#if defined(STRONG_FLAGS_SIMD_AVX2) || defined(STRONG_FLAGS_SIMD_SSE2)
+struct histogram_simd_ops {
+    using vector = bulk_vector;
+
+    static constexpr std::size_t bytes = bulk_vector_bytes;
+
+    static vector load(const std::uint8_t* src) noexcept {
+        return bulk_load(src);
+    }
+
+    static void store(std::uint8_t* dst, vector value) noexcept {
+        bulk_store(dst, value);
+    }
+
+    static vector bit_xor(vector lhs, vector rhs) noexcept {
+        return bulk_xor(lhs, rhs);
+    }
+
+    static vector bit_and(vector lhs, vector rhs) noexcept {
+        return bulk_and(lhs, rhs);
+    }
+
+    static vector bit_or(vector lhs, vector rhs) noexcept {
+        return bulk_or(lhs, rhs);
+    }
+
+#if defined(STRONG_FLAGS_SIMD_AVX2)
+    static vector byte_bit(vector value, int k) noexcept {
+        return _mm256_and_si256(_mm256_srl_epi16(value, _mm_cvtsi32_si128(k)), _mm256_set1_epi8(1));
+    }
+
+    static vector add_bytes(vector lhs, vector rhs) noexcept {
+        return _mm256_add_epi8(lhs, rhs);
+    }
+#else
+    static vector byte_bit(vector value, int k) noexcept {
+        return _mm_and_si128(_mm_srl_epi16(value, _mm_cvtsi32_si128(k)), _mm_set1_epi8(1));
+    }
+
+    static vector add_bytes(vector lhs, vector rhs) noexcept {
+        return _mm_add_epi8(lhs, rhs);
+    }
+#endif
+};
+
+using histogram_ops = histogram_simd_ops;
+#else
+using histogram_ops = histogram_scalar_ops;
+#endif
+
+// Positional popcount: counts[p] += number of vectors with bit p set, for `count` vectors read at
+// base + i * stride. Sixteen vectors at a time go through a carry-save adder tree (Harley-Seal), so
+// the per-position work happens once per 16 vectors, on byte-lane counters that are flushed before
+// they can overflow.
+template<typename Ops>
+struct positional_popcount {
+    using vector = typename Ops::vector;
+
+    static constexpr std::size_t s_positions = Ops::bytes * 8;
+    static constexpr std::size_t s_flush_blocks = 255;
+
+    static void csa(vector& high, vector& low, vector a, vector b, vector c) noexcept {
+        const vector u = Ops::bit_xor(a, b);
+        high = Ops::bit_or(Ops::bit_and(a, b), Ops::bit_and(u, c));
+        low = Ops::bit_xor(u, c);
+    }
+
+    static void add_plane(vector plane, std::uint64_t weight, std::uint64_t* counts) noexcept {
+        std::uint8_t bytes[Ops::bytes];
+        Ops::store(bytes, plane);
+        for (std::size_t b = 0; b < Ops::bytes; ++b) {
+            for (unsigned bits = bytes[b]; bits != 0; bits &= bits - 1) {
+                counts[8 * b + static_cast<std::size_t>(countr_zero(bits))] += weight;
+            }
+        }
+    }
+
+    // acc[k] holds, per byte lane b, how many blocks carried into position 8 * b + k.
+    static void flush(vector (&acc)[8], std::uint64_t* counts) noexcept {
+        for (int k = 0; k < 8; ++k) {
+            std::uint8_t bytes[Ops::bytes];
+            Ops::store(bytes, acc[k]);
+            for (std::size_t b = 0; b < Ops::bytes; ++b) {
+                counts[8 * b + static_cast<std::size_t>(k)] += 16 * std::uint64_t { bytes[b] };
+            }
+            acc[k] = vector { };
+        }
+    }
+
+    static void run(const std::uint8_t* base, std::size_t stride, std::size_t count, std::uint64_t* counts) noexcept {
+        vector ones { };
+        vector twos { };
+        vector fours { };
+        vector eights { };
+        vector acc[8] { };
+        std::size_t blocks = 0;
+        std::size_t i = 0;
+
+        for (; i + 16 <= count; i += 16) {
+            const std::uint8_t* src = base + i * stride;
+            const auto in = [src, stride](std::size_t j) {
+                return Ops::load(src + j * stride);
+            };
+
+            vector twos_a, twos_b, fours_a, fours_b, eights_a, eights_b, sixteens;
+            csa(twos_a, ones, ones, in(0), in(1));
+            csa(twos_b, ones, ones, in(2), in(3));
+            csa(fours_a, twos, twos, twos_a, twos_b);
+            csa(twos_a, ones, ones, in(4), in(5));
+            csa(twos_b, ones, ones, in(6), in(7));
+            csa(fours_b, twos, twos, twos_a, twos_b);
+            csa(eights_a, fours, fours, fours_a, fours_b);
+            csa(twos_a, ones, ones, in(8), in(9));
+            csa(twos_b, ones, ones, in(10), in(11));
+            csa(fours_a, twos, twos, twos_a, twos_b);
+            csa(twos_a, ones, ones, in(12), in(13));
+            csa(twos_b, ones, ones, in(14), in(15));
+            csa(fours_b, twos, twos, twos_a, twos_b);
+            csa(eights_b, fours, fours, fours_a, fours_b);
+            csa(sixteens, eights, eights, eights_a, eights_b);
+
+            for (int k = 0; k < 8; ++k) {
+                acc[k] = Ops::add_bytes(acc[k], Ops::byte_bit(sixteens, k));
+            }
+            if (++blocks == s_flush_blocks) {
+                flush(acc, counts);
+                blocks = 0;
+            }
+        }
+
+        flush(acc, counts);
+        add_plane(ones, 1, counts);
+        add_plane(twos, 2, counts);
+        add_plane(fours, 4, counts);
+        add_plane(eights, 8, counts);
+        for (; i < count; ++i) {
+            add_plane(Ops::load(base + i * stride), 1, counts);
+        }
+    }
+};
+
+}
+
+// Per-flag occurrence counts over any number of values. Partial histograms, e.g. one per thread,
+// combine with merge().
+template<typename FlagType>
+class histogram {
+public:
+    using flag_type = FlagType;
+    using bit_type = typename FlagType::bit_type;
+    using count_type = std::uint64_t;
+    using counts_type = std::array<count_type, FlagType::bit_count>;
+
+    static constexpr bit_type bit_count = FlagType::bit_count;
+
+    histogram() noexcept : m_counts { }, m_total { 0 } {
+    }
+
+    void add(const FlagType& value) noexcept {
+        for (bit_type bit : value.bits()) {
+            ++m_counts[bit];
+        }
+        ++m_total;
+    }
+
+    void add(const FlagType* values, std::size_t count) noexcept {
+        using kernel = detail::positional_popcount<detail::histogram_ops>;
+        using underlying_type = typename FlagType::underlying_type;
+
+        static_assert(sizeof(FlagType) == sizeof(underlying_type),
+                "Flag type must have the size of its underlying type");
+        static_assert(std::is_standard_layout<FlagType>::value, "Flag type must be standard layout");
+
+        const auto* bytes = reinterpret_cast<const std::uint8_t*>(values);
+        count_type positions[kernel::s_positions] { };
+        std::size_t done = count;
+
+        if constexpr (std::is_integral<underlying_type>::value) {
+            // Every vector holds whole values, so position p belongs to bit p % (bits per value).
+            constexpr std::size_t value_bits = sizeof(FlagType) * 8;
+            const std::size_t vectors = count * sizeof(FlagType) / detail::histogram_ops::bytes;
+            kernel::run(bytes, detail::histogram_ops::bytes, vectors, positions);
+            for (std::size_t p = 0; p < kernel::s_positions; ++p) {
+                if (p % value_bits < bit_count) {
+                    m_counts[p % value_bits] += positions[p];
+                }
+            }
+            done = vectors * detail::histogram_ops::bytes / sizeof(FlagType);
+        } else {
+            // Values span several vectors: count each vector-sized column of the values separately.
+            constexpr std::size_t columns = sizeof(FlagType) / detail::histogram_ops::bytes;
+            for (std::size_t c = 0; c < columns; ++c) {
+                kernel::run(bytes + c * detail::histogram_ops::bytes, sizeof(FlagType), count, positions);
+                for (std::size_t p = 0; p < kernel::s_positions; ++p) {
+                    const std::size_t bit = c * kernel::s_positions + p;
+                    if (bit < bit_count) {
+                        m_counts[bit] += positions[p];
+                    }
+                    positions[p] = 0;
+                }
+            }
+        }
+
+        for (std::size_t i = done; i < count; ++i) {
+            for (bit_type bit : values[i].bits()) {
+                ++m_counts[bit];
+            }
+        }
+        m_total += count;
+    }
+
+    // Splits the values across threads, each filling its own partial histogram.
+    void add(const bulk::parallel& policy, const FlagType* values, std::size_t count) {
+        const std::size_t threads = detail::parallel_threads(policy, count);
+        std::vector<histogram> partial(threads);
+        detail::parallel_chunks(threads, count, [&](std::size_t t, std::size_t begin, std::size_t end) {
+            partial[t].add(values + begin, end - begin);
+        });
+        for (const auto& h : partial) {
+            merge(h);
+        }
+    }
+
+    histogram& merge(const histogram& rhs) noexcept {
+        for (std::size_t bit = 0; bit < bit_count; ++bit) {
+            m_counts[bit] += rhs.m_counts[bit];
+        }
+        m_total += rhs.m_total;
+        return *this;
+    }
+
+    void clear() noexcept {
+        m_counts = counts_type { };
+        m_total = 0;
+    }
+
+    // Number of values added.
+    count_type total() const noexcept {
+        return m_total;
+    }
+
+    count_type operator[](bit_type bit) const noexcept {
+        return m_counts[bit];
+    }
+
+    const counts_type& counts() const noexcept {
+        return m_counts;
+    }
+
+    // Requires a type defined by STRONG_FLAGS_DEFINE_FLAGS.
+    static constexpr std::string_view name(bit_type bit) noexcept {
+        return name_of<FlagType>(bit);
+    }
+
+    // Calls function(name, count) for every flag in bit order, e.g. to export the counts as metrics.
+    // Requires a type defined by STRONG_FLAGS_DEFINE_FLAGS.
+    template<typename Function>
+    void for_each(Function&& function) const {
+        for (std::size_t bit = 0; bit < bit_count; ++bit) {
+            function(name(bit), m_counts[bit]);
+        }
+    }
+
+private:
+    counts_type m_counts;
+    count_type m_total;
+};
+
+}
+
+#endif /* INCLUDE_STRONG_FLAGS_HISTOGRAM_H_ */
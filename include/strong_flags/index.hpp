@@ -0,0 +1,794 @@
+#ifndef INCLUDE_STRONG_FLAGS_INDEX_H_
+#define INCLUDE_STRONG_FLAGS_INDEX_H_
+
+#include "bulk.hpp"
+#include "expression.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace strong_flags {
+
+namespace detail {
+
+// Row ids are split into a 16 bit container key and a 16 bit position. A container holds its positions
+// as a sorted array while that is smaller than a bitmap, as a 2^16 bit bitmap otherwise (roaring layout).
+constexpr std::size_t roaring_array_max = 4096;
+constexpr std::size_t roaring_bitmap_words = (1 << 16) / 64;
+
+struct roaring_container {
+    std::uint16_t key = 0;
+    std::uint32_t cardinality = 0;
+    std::vector<std::uint16_t> array;
+    std::vector<std::uint64_t> bitmap;
+
+    bool is_bitmap() const noexcept {
+        return !bitmap.empty();
+    }
+
+    bool contains(std::uint16_t low) const noexcept {
+        if (is_bitmap()) {
+            return (bitmap[low / 64] >> (low % 64)) & 1;
+        }
+        return std::binary_search(array.begin(), array.end(), low);
+    }
+
+    // Appending in increasing order stays on the push_back path.
+    bool insert(std::uint16_t low) {
+        if (is_bitmap()) {
+            const auto bit = std::uint64_t { 1 } << (low % 64);
+            if (bitmap[low / 64] & bit) {
+                return false;
+            }
+            bitmap[low / 64] |= bit;
+        } else if (array.empty() || array.back() < low) {
+            array.push_back(low);
+        } else {
+            const auto it = std::lower_bound(array.begin(), array.end(), low);
+            if (*it == low) {
+                return false;
+            }
+            array.insert(it, low);
+        }
+        if (++cardinality > roaring_array_max && !is_bitmap()) {
+            to_bitmap();
+        }
+        return true;
+    }
+
+    bool erase(std::uint16_t low) {
+        if (is_bitmap()) {
+            const auto bit = std::uint64_t { 1 } << (low % 64);
+            if (!(bitmap[low / 64] & bit)) {
+                return false;
+            }
+            bitmap[low / 64] &= ~bit;
+        } else {
+            const auto it = std::lower_bound(array.begin(), array.end(), low);
+            if (it == array.end() || *it != low) {
+                return false;
+            }
+            array.erase(it);
+        }
+        if (--cardinality <= roaring_array_max && is_bitmap()) {
+            to_array();
+        }
+        return true;
+    }
+
+    void to_bitmap() {
+        bitmap.assign(roaring_bitmap_words, 0);
+        for (auto low : array) {
+            bitmap[low / 64] |= std::uint64_t { 1 } << (low % 64);
+        }
+        array = std::vector<std::uint16_t>();
+    }
+
+    void to_array() {
+        array.clear();
+        array.reserve(cardinality);
+        for_each([this](std::uint16_t low) {
+            array.push_back(low);
+        });
+        bitmap = std::vector<std::uint64_t>();
+    }
+
+    // Picks the representation after a set operation filled one in directly.
+    void normalize() {
+        if (is_bitmap() && cardinality <= roaring_array_max) {
+            to_array();
+        } else if (!is_bitmap() && cardinality > roaring_array_max) {
+            to_bitmap();
+        }
+    }
+
+    template<typename Function>
+    void for_each(Function&& function) const {
+        if (is_bitmap()) {
+            for (std::size_t w = 0; w < roaring_bitmap_words; ++w) {
+                for (auto bits = bitmap[w]; bits != 0; bits &= bits - 1) {
+                    function(static_cast<std::uint16_t>(w * 64 + static_cast<std::size_t>(countr_zero(bits))));
+                }
+            }
+        } else {
+            for (auto low : array) {
+                function(low);
+            }
+        }
+    }
+};
+
+struct roaring_and_op {
+    static std::uint64_t word(std::uint64_t lhs, std::uint64_t rhs) noexcept {
+        return lhs & rhs;
+    }
+
+#if defined(STRONG_FLAGS_SIMD_AVX2) || defined(STRONG_FLAGS_SIMD_SSE2)
+    static bulk_vector vector(bulk_vector lhs, bulk_vector rhs) noexcept {
+        return bulk_and(lhs, rhs);
+    }
+#endif
+};
+
+struct roaring_or_op {
+    static std::uint64_t word(std::uint64_t lhs, std::uint64_t rhs) noexcept {
+        return lhs | rhs;
+    }
+
+#if defined(STRONG_FLAGS_SIMD_AVX2) || defined(STRONG_FLAGS_SIMD_SSE2)
+    static bulk_vector vector(bulk_vector lhs, bulk_vector rhs) noexcept {
+        return bulk_or(lhs, rhs);
+    }
+#endif
+};
+
+struct roaring_andnot_op {
+    static std::uint64_t word(std::uint64_t lhs, std::uint64_t rhs) noexcept {
+        return lhs & ~rhs;
+    }
+
+#if defined(STRONG_FLAGS_SIMD_AVX2) || defined(STRONG_FLAGS_SIMD_SSE2)
+    static bulk_vector vector(bulk_vector lhs, bulk_vector rhs) noexcept {
+        return bulk_andnot(lhs, rhs);
+    }
+#endif
+};
+
+// dst = Op(lhs, rhs) over two full bitmaps; returns the cardinality of the result.
+template<typename Op>
+std::uint32_t roaring_bitmap_apply(std::uint64_t* dst, const std::uint64_t* lhs, const std::uint64_t* rhs) noexcept {
+#if defined(STRONG_FLAGS_SIMD_AVX2) || defined(STRONG_FLAGS_SIMD_SSE2)
+    constexpr std::size_t step = bulk_vector_bytes / sizeof(std::uint64_t);
+    for (std::size_t i = 0; i < roaring_bitmap_words; i += step) {
+        bulk_store(dst + i, Op::vector(bulk_load(lhs + i), bulk_load(rhs + i)));
+    }
+#else
+    for (std::size_t i = 0; i < roaring_bitmap_words; ++i) {
+        dst[i] = Op::word(lhs[i], rhs[i]);
+    }
+#endif
+    std::uint32_t res = 0;
+    for (std::size_t i = 0; i < roaring_bitmap_words; ++i) {
+        res += static_cast<std::uint32_t>(popcount(dst[i]));
+    }
+    return res;
+}
+
+#if defined(STRONG_FLAGS_SIMD_AVX2) || defined(STRONG_FLAGS_SIMD_SSE2)
+// Rotates the eight 16 bit lanes of `value` by K lanes.
+template<int K>
+inline __m128i roaring_rotate(__m128i value) noexcept {
+    return _mm_or_si128(_mm_srli_si128(value, 2 * K), _mm_slli_si128(value, 16 - 2 * K));
+}
+#endif
+
+// Sorted array intersection. Eight by eight blocks are compared all against all with one compare per
+// rotation of the right block; the block with the smaller last element is then advanced. A scalar merge
+// finishes the tails.
+inline std::size_t roaring_intersect(const std::uint16_t* lhs, std::size_t lhs_count, const std::uint16_t* rhs,
+        std::size_t rhs_count, std::uint16_t* out) noexcept {
+    std::size_t i = 0;
+    std::size_t j = 0;
+    std::size_t res = 0;
+#if defined(STRONG_FLAGS_SIMD_AVX2) || defined(STRONG_FLAGS_SIMD_SSE2)
+    const std::size_t lhs_blocks = lhs_count & ~std::size_t { 7 };
+    const std::size_t rhs_blocks = rhs_count & ~std::size_t { 7 };
+    while (i < lhs_blocks && j < rhs_blocks) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + j));
+        __m128i hits = _mm_cmpeq_epi16(a, b);
+        hits = _mm_or_si128(hits, _mm_cmpeq_epi16(a, roaring_rotate<1>(b)));
+        hits = _mm_or_si128(hits, _mm_cmpeq_epi16(a, roaring_rotate<2>(b)));
+        hits = _mm_or_si128(hits, _mm_cmpeq_epi16(a, roaring_rotate<3>(b)));
+        hits = _mm_or_si128(hits, _mm_cmpeq_epi16(a, roaring_rotate<4>(b)));
+        hits = _mm_or_si128(hits, _mm_cmpeq_epi16(a, roaring_rotate<5>(b)));
+        hits = _mm_or_si128(hits, _mm_cmpeq_epi16(a, roaring_rotate<6>(b)));
+        hits = _mm_or_si128(hits, _mm_cmpeq_epi16(a, roaring_rotate<7>(b)));
+        for (auto bits = static_cast<unsigned>(_mm_movemask_epi8(hits)) & 0x5555U; bits != 0; bits &= bits - 1) {
+            out[res++] = lhs[i + static_cast<std::size_t>(countr_zero(bits)) / 2];
+        }
+
+        const auto lhs_last = lhs[i + 7];
+        const auto rhs_last = rhs[j + 7];
+        i += lhs_last <= rhs_last ? 8 : 0;
+        j += rhs_last <= lhs_last ? 8 : 0;
+    }
+#endif
+    while (i < lhs_count && j < rhs_count) {
+        if (lhs[i] < rhs[j]) {
+            ++i;
+        } else if (rhs[j] < lhs[i]) {
+            ++j;
+        } else {
+            out[res++] = lhs[i];
+            ++i;
+            ++j;
+        }
+    }
+    return res;
+}
+
+inline roaring_container roaring_and(const roaring_container& lhs, const roaring_container& rhs) {
+    roaring_container res;
+    res.key = lhs.key;
+    if (lhs.is_bitmap() && rhs.is_bitmap()) {
+        res.bitmap.resize(roaring_bitmap_words);
+        res.cardinality = roaring_bitmap_apply<roaring_and_op>(res.bitmap.data(), lhs.bitmap.data(),
+                rhs.bitmap.data());
+        res.normalize();
+    } else if (lhs.is_bitmap() || rhs.is_bitmap()) {
+        const auto& array = lhs.is_bitmap() ? rhs : lhs;
+        const auto& bitmap = lhs.is_bitmap() ? lhs : rhs;
+        res.array.reserve(array.cardinality);
+        for (auto low : array.array) {
+            if (bitmap.contains(low)) {
+                res.array.push_back(low);
+            }
+        }
+        res.cardinality = static_cast<std::uint32_t>(res.array.size());
+    } else {
+        res.array.resize(std::min(lhs.array.size(), rhs.array.size()));
+        res.cardinality = static_cast<std::uint32_t>(roaring_intersect(lhs.array.data(), lhs.array.size(),
+                rhs.array.data(), rhs.array.size(), res.array.data()));
+        res.array.resize(res.cardinality);
+    }
+    return res;
+}
+
+inline roaring_container roaring_or(const roaring_container& lhs, const roaring_container& rhs) {
+    roaring_container res;
+    res.key = lhs.key;
+    if (lhs.is_bitmap() && rhs.is_bitmap()) {
+        res.bitmap.resize(roaring_bitmap_words);
+        res.cardinality = roaring_bitmap_apply<roaring_or_op>(res.bitmap.data(), lhs.bitmap.data(),
+                rhs.bitmap.data());
+    } else if (lhs.is_bitmap() || rhs.is_bitmap() || lhs.cardinality + rhs.cardinality > roaring_array_max) {
+        res = lhs.is_bitmap() ? lhs : rhs;
+        res.key = lhs.key;
+        if (!res.is_bitmap()) {
+            res.to_bitmap();
+        }
+        const auto& other = lhs.is_bitmap() ? rhs : lhs;
+        other.for_each([&res](std::uint16_t low) {
+            res.bitmap[low / 64] |= std::uint64_t { 1 } << (low % 64);
+        });
+        res.cardinality = 0;
+        for (auto word : res.bitmap) {
+            res.cardinality += static_cast<std::uint32_t>(popcount(word));
+        }
+        res.normalize();
+    } else {
+        res.array.resize(lhs.array.size() + rhs.array.size());
+        const auto end = std::set_union(lhs.array.begin(), lhs.array.end(), rhs.array.begin(), rhs.array.end(),
+                res.array.begin());
+        res.array.erase(end, res.array.end());
+        res.cardinality = static_cast<std::uint32_t>(res.array.size());
+    }
+    return res;
+}
+
+// lhs & ~rhs
+inline roaring_container roaring_andnot(const roaring_container& lhs, const roaring_container& rhs) {
+    roaring_container res;
+    res.key = lhs.key;
+    if (lhs.is_bitmap() && rhs.is_bitmap()) {
+        res.bitmap.resize(roaring_bitmap_words);
+        res.cardinality = roaring_bitmap_apply<roaring_andnot_op>(res.bitmap.data(), lhs.bitmap.data(),
+                rhs.bitmap.data());
+        res.normalize();
+    } else if (lhs.is_bitmap()) {
+        res = lhs;
+        for (auto low : rhs.array) {
+            const auto bit = std::uint64_t { 1 } << (low % 64);
+            res.cardinality -= (res.bitmap[low / 64] & bit) != 0;
+            res.bitmap[low / 64] &= ~bit;
+        }
+        res.normalize();
+    } else {
+        res.array.reserve(lhs.array.size());
+        if (rhs.is_bitmap()) {
+            for (auto low : lhs.array) {
+                if (!rhs.contains(low)) {
+                    res.array.push_back(low);
+                }
+            }
+        } else {
+            std::set_difference(lhs.array.begin(), lhs.array.end(), rhs.array.begin(), rhs.array.end(),
+                    std::back_inserter(res.array));
+        }
+        res.cardinality = static_cast<std::uint32_t>(res.array.size());
+    }
+    return res;
+}
+
+}
+
+// Compressed set of 32 bit row ids, ordered by id.
+class row_set {
+public:
+    using value_type = std::uint32_t;
+    using size_type = std::size_t;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::uint32_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = std::uint32_t;
+
+        const_iterator() noexcept : m_it { }, m_end { }, m_pos { 0 }, m_bits { 0 } {
+        }
+
+        const_iterator(const detail::roaring_container* it, const detail::roaring_container* end) noexcept
+                : m_it { it }, m_end { end }, m_pos { 0 }, m_bits { 0 } {
+            enter();
+        }
+
+        std::uint32_t operator*() const noexcept {
+            const std::uint32_t high = std::uint32_t { m_it->key } << 16;
+            if (m_it->is_bitmap()) {
+                return high | static_cast<std::uint32_t>(m_pos * 64 + static_cast<std::size_t>(
+                        detail::countr_zero(m_bits)));
+            }
+            return high | m_it->array[m_pos];
+        }
+
+        const_iterator& operator++() noexcept {
+            if (m_it->is_bitmap()) {
+                m_bits &= m_bits - 1;
+                while (m_bits == 0 && ++m_pos < detail::roaring_bitmap_words) {
+                    m_bits = m_it->bitmap[m_pos];
+                }
+                if (m_bits == 0) {
+                    next_container();
+                }
+            } else if (++m_pos == m_it->array.size()) {
+                next_container();
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) noexcept {
+            auto res = *this;
+            ++*this;
+            return res;
+        }
+
+        bool operator==(const const_iterator& rhs) const noexcept {
+            return m_it == rhs.m_it && m_pos == rhs.m_pos && m_bits == rhs.m_bits;
+        }
+
+        bool operator!=(const const_iterator& rhs) const noexcept {
+            return !(*this == rhs);
+        }
+
+    private:
+        const detail::roaring_container* m_it;
+        const detail::roaring_container* m_end;
+        std::size_t m_pos;
+        std::uint64_t m_bits;
+
+        // Containers are never empty, so the first position of a container always exists.
+        void enter() noexcept {
+            m_pos = 0;
+            m_bits = 0;
+            if (m_it == m_end) {
+                return;
+            }
+            if (m_it->is_bitmap()) {
+                while ((m_bits = m_it->bitmap[m_pos]) == 0) {
+                    ++m_pos;
+                }
+            }
+        }
+
+        void next_container() noexcept {
+            ++m_it;
+            enter();
+        }
+    };
+
+    using iterator = const_iterator;
+
+    row_set() = default;
+
+    bool contains(std::uint32_t row) const noexcept {
+        const auto* container = find(high(row));
+        return container != nullptr && container->contains(low(row));
+    }
+
+    // Returns false if the row was already present.
+    bool insert(std::uint32_t row) {
+        const auto key = high(row);
+        if (m_containers.empty() || m_containers.back().key < key) {
+            m_containers.emplace_back();
+            m_containers.back().key = key;
+            return m_containers.back().insert(low(row));
+        }
+        auto it = lower_bound(key);
+        if (it == m_containers.end() || it->key != key) {
+            it = m_containers.emplace(it);
+            it->key = key;
+        }
+        return it->insert(low(row));
+    }
+
+    // Returns false if the row was not present.
+    bool erase(std::uint32_t row) {
+        const auto key = high(row);
+        const auto it = lower_bound(key);
+        if (it == m_containers.end() || it->key != key || !it->erase(low(row))) {
+            return false;
+        }
+        if (it->cardinality == 0) {
+            m_containers.erase(it);
+        }
+        return true;
+    }
+
+    void clear() noexcept {
+        m_containers.clear();
+    }
+
+    size_type size() const noexcept {
+        size_type res = 0;
+        for (const auto& container : m_containers) {
+            res += container.cardinality;
+        }
+        return res;
+    }
+
+    bool empty() const noexcept {
+        return m_containers.empty();
+    }
+
+    const_iterator begin() const noexcept {
+        return const_iterator { m_containers.data(), m_containers.data() + m_containers.size() };
+    }
+
+    const_iterator end() const noexcept {
+        const auto* last = m_containers.data() + m_containers.size();
+        return const_iterator { last, last };
+    }
+
+    // Calls function(row) for every row in increasing order; cheaper than iterating.
+    template<typename Function>
+    void for_each(Function&& function) const {
+        for (const auto& container : m_containers) {
+            const std::uint32_t base = std::uint32_t { container.key } << 16;
+            container.for_each([&function, base](std::uint16_t low) {
+                function(base | low);
+            });
+        }
+    }
+
+    std::vector<std::uint32_t> to_vector() const {
+        std::vector<std::uint32_t> res;
+        res.reserve(size());
+        for_each([&res](std::uint32_t row) {
+            res.push_back(row);
+        });
+        return res;
+    }
+
+    row_set& operator&=(const row_set& rhs) {
+        return *this = *this & rhs;
+    }
+
+    row_set& operator|=(const row_set& rhs) {
+        return *this = *this | rhs;
+    }
+
+    row_set& operator-=(const row_set& rhs) {
+        return *this = *this - rhs;
+    }
+
+    friend row_set operator&(const row_set& lhs, const row_set& rhs) {
+        row_set res;
+        auto l = lhs.m_containers.begin();
+        auto r = rhs.m_containers.begin();
+        while (l != lhs.m_containers.end() && r != rhs.m_containers.end()) {
+            if (l->key < r->key) {
+                ++l;
+            } else if (r->key < l->key) {
+                ++r;
+            } else {
+                res.push(detail::roaring_and(*l++, *r++));
+            }
+        }
+        return res;
+    }
+
+    friend row_set operator|(const row_set& lhs, const row_set& rhs) {
+        row_set res;
+        auto l = lhs.m_containers.begin();
+        auto r = rhs.m_containers.begin();
+        while (l != lhs.m_containers.end() || r != rhs.m_containers.end()) {
+            if (r == rhs.m_containers.end() || (l != lhs.m_containers.end() && l->key < r->key)) {
+                res.m_containers.push_back(*l++);
+            } else if (l == lhs.m_containers.end() || r->key < l->key) {
+                res.m_containers.push_back(*r++);
+            } else {
+                res.push(detail::roaring_or(*l++, *r++));
+            }
+        }
+        return res;
+    }
+
+    // Rows of lhs that are not in rhs.
+    friend row_set operator-(const row_set& lhs, const row_set& rhs) {
+        row_set res;
+        auto r = rhs.m_containers.begin();
+        for (const auto& container : lhs.m_containers) {
+            while (r != rhs.m_containers.end() && r->key < container.key) {
+                ++r;
+            }
+            if (r != rhs.m_containers.end() && r->key == container.key) {
+                res.push(detail::roaring_andnot(container, *r));
+            } else {
+                res.m_containers.push_back(container);
+            }
+        }
+        return res;
+    }
+
+    friend bool operator==(const row_set& lhs, const row_set& rhs) noexcept {
+        return std::equal(lhs.m_containers.begin(), lhs.m_containers.end(), rhs.m_containers.begin(),
+                rhs.m_containers.end(), [](const detail::roaring_container& a, const detail::roaring_container& b) {
+                    return a.key == b.key && a.cardinality == b.cardinality && a.array == b.array
+                            && a.bitmap == b.bitmap;
+                });
+    }
+
+    friend bool operator!=(const row_set& lhs, const row_set& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+private:
+    std::vector<detail::roaring_container> m_containers;
+
+    static std::uint16_t high(std::uint32_t row) noexcept {
+        return static_cast<std::uint16_t>(row >> 16);
+    }
+
+    static std::uint16_t low(std::uint32_t row) noexcept {
+        return static_cast<std::uint16_t>(row);
+    }
+
+    std::vector<detail::roaring_container>::iterator lower_bound(std::uint16_t key) {
+        return std::lower_bound(m_containers.begin(), m_containers.end(), key,
+                [](const detail::roaring_container& container, std::uint16_t k) {
+                    return container.key < k;
+                });
+    }
+
+    const detail::roaring_container* find(std::uint16_t key) const noexcept {
+        const auto it = std::lower_bound(m_containers.begin(), m_containers.end(), key,
+                [](const detail::roaring_container& container, std::uint16_t k) {
+                    return container.key < k;
+                });
+        return it != m_containers.end() && it->key == key ? &*it : nullptr;
+    }
+
+    void push(detail::roaring_container&& container) {
+        if (container.cardinality != 0) {
+            m_containers.push_back(std::move(container));
+        }
+    }
+};
+
+// Bitmap index over rows of flag values: one row_set per flag, plus the set of live rows. Queries
+// combine the per-flag sets instead of scanning the values.
+template<typename FlagType>
+class index {
+public:
+    using flag_type = FlagType;
+    using bit_type = typename FlagType::bit_type;
+    using row_type = std::uint32_t;
+
+    static constexpr bit_type bit_count = FlagType::bit_count;
+
+    index() = default;
+
+    // Adds a row after the highest row so far and returns its id.
+    row_type append(const FlagType& value) {
+        const row_type row = m_next;
+        insert(row, value);
+        return row;
+    }
+
+    // Stores `value` at `row`, replacing the row if it exists.
+    void insert(row_type row, const FlagType& value) {
+        if (!m_rows.insert(row)) {
+            clear_row(row);
+        }
+        for (bit_type bit : value.bits()) {
+            m_bits[bit].insert(row);
+        }
+        m_next = std::max<row_type>(m_next, row + 1);
+    }
+
+    // Returns false if the row does not exist.
+    bool erase(row_type row) {
+        if (!m_rows.erase(row)) {
+            return false;
+        }
+        clear_row(row);
+        return true;
+    }
+
+    bool contains(row_type row) const noexcept {
+        return m_rows.contains(row);
+    }
+
+    // Reassembles the value of a row from the per-flag sets.
+    FlagType value(row_type row) const noexcept {
+        FlagType res;
+        for (bit_type bit = 0; bit < bit_count; ++bit) {
+            if (m_bits[bit].contains(row)) {
+                res.set(bit);
+            }
+        }
+        return res;
+    }
+
+    std::size_t size() const noexcept {
+        return m_rows.size();
+    }
+
+    bool empty() const noexcept {
+        return m_rows.empty();
+    }
+
+    void clear() noexcept {
+        m_rows.clear();
+        for (auto& rows : m_bits) {
+            rows.clear();
+        }
+        m_next = 0;
+    }
+
+    const row_set& rows() const noexcept {
+        return m_rows;
+    }
+
+    const row_set& rows(bit_type bit) const noexcept {
+        return m_bits[bit];
+    }
+
+    // Rows where value.test_all(mask); every row for an empty mask. Smallest sets are intersected first.
+    row_set all_of(const FlagType& mask) const {
+        std::vector<const row_set*> sets;
+        for (bit_type bit : mask.bits()) {
+            sets.push_back(&m_bits[bit]);
+        }
+        if (sets.empty()) {
+            return m_rows;
+        }
+        std::sort(sets.begin(), sets.end(), [](const row_set* a, const row_set* b) {
+            return a->size() < b->size();
+        });
+        row_set res = *sets.front();
+        for (std::size_t i = 1; i < sets.size() && !res.empty(); ++i) {
+            res &= *sets[i];
+        }
+        return res;
+    }
+
+    // Rows where value.test_any(mask).
+    row_set any_of(const FlagType& mask) const {
+        row_set res;
+        for (bit_type bit : mask.bits()) {
+            res |= m_bits[bit];
+        }
+        return res;
+    }
+
+    // Rows where !value.test_any(mask).
+    row_set none_of(const FlagType& mask) const {
+        return m_rows - any_of(mask);
+    }
+
+    // Rows where value.test_all(all) && !value.test_any(none).
+    row_set where(const FlagType& all, const FlagType& none) const {
+        auto res = all_of(all);
+        for (bit_type bit : none.bits()) {
+            if (res.empty()) {
+                break;
+            }
+            res -= m_bits[bit];
+        }
+        return res;
+    }
+
+    // Rows matching a lazy expression read as a predicate: an operand matches the rows that have all of
+    // its flags, and &, |, ^ and ~ combine those matches. where(lazy(A) & B | C) selects the rows with
+    // both A and B, plus the rows with C.
+    template<typename Derived>
+    row_set where(const expression<Derived, FlagType>& expr) const {
+        static_assert(!Derived::s_array, "Expressions over arrays are evaluated with bulk::assign");
+        return match(static_cast<const Derived&>(expr));
+    }
+
+private:
+    row_set m_rows;
+    std::array<row_set, bit_count> m_bits;
+    row_type m_next = 0;
+
+    template<typename Expression>
+    struct is_not : std::false_type {
+    };
+
+    template<typename Operand>
+    struct is_not<not_expression<Operand>> : std::true_type {
+    };
+
+    row_set match(const value_expression<FlagType>& operand) const {
+        return all_of(operand.value());
+    }
+
+    // x & ~y is a difference, so the complement of y is never built.
+    template<typename Op, typename Lhs, typename Rhs>
+    row_set match(const binary_expression<Op, Lhs, Rhs>& node) const {
+        if constexpr (std::is_same<Op, detail::expression_and>::value) {
+            if constexpr (is_not<Rhs>::value) {
+                return match(node.lhs()) - match(node.rhs().operand());
+            } else if constexpr (is_not<Lhs>::value) {
+                return match(node.rhs()) - match(node.lhs().operand());
+            } else {
+                auto res = match(node.lhs());
+                if (!res.empty()) {
+                    res &= match(node.rhs());
+                }
+                return res;
+            }
+        } else if constexpr (std::is_same<Op, detail::expression_or>::value) {
+            return match(node.lhs()) | match(node.rhs());
+        } else {
+            const auto lhs = match(node.lhs());
+            const auto rhs = match(node.rhs());
+            return (lhs | rhs) - (lhs & rhs);
+        }
+    }
+
+    template<typename Operand>
+    row_set match(const not_expression<Operand>& node) const {
+        return m_rows - match(node.operand());
+    }
+
+    void clear_row(row_type row) {
+        for (auto& rows : m_bits) {
+            rows.erase(row);
+        }
+    }
+};
+
+}
+
+#endif /* INCLUDE_STRONG_FLAGS_INDEX_H_ */
@@ -0,0 +1,304 @@
+#ifndef INCLUDE_STRONG_FLAGS_MAPPED_H_
+#define INCLUDE_STRONG_FLAGS_MAPPED_H_
+
+#include "strong_flags.hpp"
+#include "codec.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define STRONG_FLAGS_HAS_MMAP 1
+#endif
+
+// File layout, all fields little endian:
+//
+//   0   magic "SFMV"
+//   4   u16 version
+//   6   u16 header size, a multiple of 64; the values start here
+//   8   u32 bit count
+//   12  u16 bits of the underlying type
+//   14  u16 size of one value in bytes
+//   16  u64 number of values
+//   24  u64 hash of the flag names, in bit order
+//   32  u16 length of the type name, then the name, zero padded up to the header size
+//
+// The values follow as their in-memory representation on a little endian host: the underlying integer,
+// or the 64 bit words of a wide type, lowest word first.
+
+namespace strong_flags {
+
+enum class map_status {
+    ok,
+    io_error,
+    bad_header,
+    type_mismatch,
+    truncated,
+    misaligned
+};
+
+namespace detail {
+
+constexpr std::uint8_t mapped_magic[4] = { 'S', 'F', 'M', 'V' };
+constexpr std::uint16_t mapped_version = 1;
+constexpr std::size_t mapped_fixed_header = 34;
+constexpr std::size_t mapped_alignment = 64;
+
+template<typename FlagType, typename = void>
+struct mapped_type_name {
+    static constexpr std::string_view s_value { };
+};
+
+template<typename FlagType>
+struct mapped_type_name<FlagType, std::void_t<decltype(FlagType::type_name)>> {
+    static constexpr std::string_view s_value = FlagType::type_name;
+};
+
+template<typename FlagType>
+constexpr std::size_t mapped_header_size() noexcept {
+    const std::size_t size = mapped_fixed_header + mapped_type_name<FlagType>::s_value.size();
+    return (size + mapped_alignment - 1) / mapped_alignment * mapped_alignment;
+}
+
+template<typename FlagType>
+constexpr std::uint64_t mapped_names_hash() noexcept {
+    return codec_names<FlagType>::hash(0xcbf29ce484222325ULL);
+}
+
+inline bool little_endian_host() noexcept {
+    const std::uint16_t probe = 1;
+    unsigned char first;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+inline void store_le(unsigned char* out, std::uint64_t value, std::size_t bytes) noexcept {
+    for (std::size_t i = 0; i < bytes; ++i) {
+        out[i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+}
+
+inline std::uint64_t load_le(const unsigned char* in, std::size_t bytes) noexcept {
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < bytes; ++i) {
+        value |= static_cast<std::uint64_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+template<typename FlagType>
+void check_mappable() noexcept {
+    static_assert(std::is_trivially_copyable<FlagType>::value, "Flag type must be trivially copyable");
+    static_assert(std::is_standard_layout<FlagType>::value, "Flag type must be standard layout");
+    static_assert(sizeof(FlagType) == sizeof(typename FlagType::underlying_type),
+            "Flag type must have the size of its underlying type");
+    static_assert(alignof(FlagType) <= mapped_alignment, "Flag type is aligned beyond the file layout");
+}
+
+}
+
+// Writes `count` values in the mapped file layout. Returns false if the stream failed.
+template<typename FlagType>
+bool write_mapped(std::ostream& out, const FlagType* values, std::size_t count) {
+    detail::check_mappable<FlagType>();
+    using traits = detail::codec_traits<FlagType>;
+    constexpr auto type_name = detail::mapped_type_name<FlagType>::s_value;
+    constexpr std::size_t header_size = detail::mapped_header_size<FlagType>();
+
+    unsigned char header[header_size] { };
+    std::memcpy(header, detail::mapped_magic, 4);
+    detail::store_le(header + 4, detail::mapped_version, 2);
+    detail::store_le(header + 6, header_size, 2);
+    detail::store_le(header + 8, FlagType::bit_count, 4);
+    detail::store_le(header + 12, 8 * sizeof(typename FlagType::underlying_type), 2);
+    detail::store_le(header + 14, sizeof(FlagType), 2);
+    detail::store_le(header + 16, count, 8);
+    detail::store_le(header + 24, detail::mapped_names_hash<FlagType>(), 8);
+    detail::store_le(header + 32, type_name.size(), 2);
+    std::memcpy(header + detail::mapped_fixed_header, type_name.data(), type_name.size());
+    out.write(reinterpret_cast<const char*>(header), header_size);
+
+    if (detail::little_endian_host()) {
+        out.write(reinterpret_cast<const char*>(values), static_cast<std::streamsize>(count * sizeof(FlagType)));
+    } else {
+        constexpr std::size_t word_size = sizeof(FlagType) / traits::s_words;
+        unsigned char bytes[sizeof(FlagType)];
+        for (std::size_t i = 0; i < count && out; ++i) {
+            for (std::size_t w = 0; w < traits::s_words; ++w) {
+                detail::store_le(bytes + w * word_size, traits::word(values[i], w), word_size);
+            }
+            out.write(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+        }
+    }
+    return static_cast<bool>(out);
+}
+
+// Read-only view of a file written by write_mapped(). The values are used in place, without a copy or a
+// per-value conversion, which needs a little endian host; big endian hosts report type_mismatch. Opening
+// checks the header against FlagType but not the values; verify() does that in one pass.
+template<typename FlagType>
+class mapped_flag_view {
+public:
+    using value_type = FlagType;
+    using const_iterator = const FlagType*;
+
+    mapped_flag_view() noexcept = default;
+
+#if defined(STRONG_FLAGS_HAS_MMAP)
+    // Maps the file at `path` for as long as the view lives.
+    explicit mapped_flag_view(const char* path) noexcept {
+        const int fd = ::open(path, O_RDONLY);
+        struct stat info;
+        if (fd < 0 || ::fstat(fd, &info) != 0) {
+            m_status = map_status::io_error;
+        } else if (info.st_size == 0) {
+            m_status = map_status::bad_header;
+        } else {
+            void* data = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+            if (data == MAP_FAILED) {
+                m_status = map_status::io_error;
+            } else {
+                m_mapping = data;
+                m_mapping_size = static_cast<std::size_t>(info.st_size);
+                open(data, m_mapping_size);
+            }
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+#endif
+
+    // Views a file image already in memory, which must outlive the view.
+    mapped_flag_view(const void* data, std::size_t size) noexcept {
+        open(data, size);
+    }
+
+    mapped_flag_view(mapped_flag_view&& other) noexcept {
+        swap(other);
+    }
+
+    mapped_flag_view& operator=(mapped_flag_view&& other) noexcept {
+        mapped_flag_view { std::move(other) }.swap(*this);
+        return *this;
+    }
+
+    ~mapped_flag_view() {
+#if defined(STRONG_FLAGS_HAS_MMAP)
+        if (m_mapping != nullptr) {
+            ::munmap(m_mapping, m_mapping_size);
+        }
+#endif
+    }
+
+    void swap(mapped_flag_view& other) noexcept {
+        std::swap(m_mapping, other.m_mapping);
+        std::swap(m_mapping_size, other.m_mapping_size);
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        std::swap(m_status, other.m_status);
+    }
+
+    map_status status() const noexcept {
+        return m_status;
+    }
+
+    explicit operator bool() const noexcept {
+        return m_status == map_status::ok;
+    }
+
+    const FlagType* data() const noexcept {
+        return m_data;
+    }
+
+    std::size_t size() const noexcept {
+        return m_size;
+    }
+
+    bool empty() const noexcept {
+        return m_size == 0;
+    }
+
+    const FlagType& operator[](std::size_t index) const noexcept {
+        return m_data[index];
+    }
+
+    const_iterator begin() const noexcept {
+        return m_data;
+    }
+
+    const_iterator end() const noexcept {
+        return m_data + m_size;
+    }
+
+    // True if no value has bits outside of FlagType, which the operators of FlagType rely on.
+    bool verify() const noexcept {
+        for (const auto& value : *this) {
+            if (FlagType::from_underlying_type(value.to_underlying_type()) != value) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    void* m_mapping = nullptr;
+    std::size_t m_mapping_size = 0;
+    const FlagType* m_data = nullptr;
+    std::size_t m_size = 0;
+    map_status m_status = map_status::ok;
+
+    void open(const void* data, std::size_t size) noexcept {
+        detail::check_mappable<FlagType>();
+        const auto* in = static_cast<const unsigned char*>(data);
+        if (size < detail::mapped_fixed_header || std::memcmp(in, detail::mapped_magic, 4) != 0
+                || detail::load_le(in + 4, 2) != detail::mapped_version) {
+            m_status = map_status::bad_header;
+            return;
+        }
+        const auto header_size = detail::load_le(in + 6, 2);
+        const auto name_size = detail::load_le(in + 32, 2);
+        if (header_size % detail::mapped_alignment != 0 || header_size < detail::mapped_fixed_header + name_size
+                || header_size > size) {
+            m_status = map_status::bad_header;
+            return;
+        }
+
+        constexpr auto type_name = detail::mapped_type_name<FlagType>::s_value;
+        const std::string_view name { reinterpret_cast<const char*>(in + detail::mapped_fixed_header),
+                static_cast<std::size_t>(name_size) };
+        if (!detail::little_endian_host() || detail::load_le(in + 8, 4) != FlagType::bit_count
+                || detail::load_le(in + 12, 2) != 8 * sizeof(typename FlagType::underlying_type)
+                || detail::load_le(in + 14, 2) != sizeof(FlagType)
+                || detail::load_le(in + 24, 8) != detail::mapped_names_hash<FlagType>() || name != type_name) {
+            m_status = map_status::type_mismatch;
+            return;
+        }
+
+        const auto count = detail::load_le(in + 16, 8);
+        if (count > (size - header_size) / sizeof(FlagType)) {
+            m_status = map_status::truncated;
+            return;
+        }
+        if (reinterpret_cast<std::uintptr_t>(in + header_size) % alignof(FlagType) != 0) {
+            m_status = map_status::misaligned;
+            return;
+        }
+        m_data = reinterpret_cast<const FlagType*>(in + header_size);
+        m_size = static_cast<std::size_t>(count);
+        m_status = map_status::ok;
+    }
+};
+
+}
+
+#endif /* INCLUDE_STRONG_FLAGS_MAPPED_H_ */
@@ -0,0 +1,297 @@
+
+#ifndef INCLUDE_STRONG_FLAGS_PACKED_ARRAY_H_
+#define INCLUDE_STRONG_FLAGS_PACKED_ARRAY_H_
+
+#include "strong_flags.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace strong_flags {
+
+// Array of flag values stored back to back in exactly FlagType::bit_count bits each, so a 3 flag type
+// takes 3 bits per element. Elements may straddle two 64 bit words; one spare word at the end lets
+// every access read and write both words without a bounds check. Bulk algorithms work on plain
+// arrays, which get() and set() convert to and from in batches.
+template<typename FlagType>
+class packed_flag_array {
+private:
+    using underlying_type = typename FlagType::underlying_type;
+
+    static_assert(std::is_integral<underlying_type>::value,
+            "packed_flag_array needs an integer flag type; wide types are already stored densely");
+
+public:
+    using value_type = FlagType;
+    using size_type = std::size_t;
+    using word_type = std::uint64_t;
+
+    static constexpr size_type bits_per_element = FlagType::bit_count;
+
+    class reference {
+    public:
+        operator FlagType() const noexcept {
+            return m_array->get(m_index);
+        }
+
+        reference& operator=(const FlagType& value) noexcept {
+            m_array->set(m_index, value);
+            return *this;
+        }
+
+        reference& operator=(const reference& rhs) noexcept {
+            return *this = static_cast<FlagType>(rhs);
+        }
+
+        reference& operator|=(const FlagType& rhs) noexcept {
+            return *this = static_cast<FlagType>(*this) | rhs;
+        }
+
+        reference& operator&=(const FlagType& rhs) noexcept {
+            return *this = static_cast<FlagType>(*this) & rhs;
+        }
+
+        reference& operator^=(const FlagType& rhs) noexcept {
+            return *this = static_cast<FlagType>(*this) ^ rhs;
+        }
+
+        bool operator==(const FlagType& rhs) const noexcept {
+            return static_cast<FlagType>(*this) == rhs;
+        }
+
+        bool operator!=(const FlagType& rhs) const noexcept {
+            return static_cast<FlagType>(*this) != rhs;
+        }
+
+        bool test(typename FlagType::bit_type bit) const noexcept {
+            return static_cast<FlagType>(*this).test(bit);
+        }
+
+    private:
+        friend class packed_flag_array;
+
+        reference(packed_flag_array* array, size_type index) noexcept : m_array { array }, m_index { index } {
+        }
+
+        packed_flag_array* m_array;
+        size_type m_index;
+    };
+
+    template<typename Array, typename Reference>
+    class basic_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = FlagType;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Reference;
+
+        basic_iterator() noexcept : m_array { nullptr }, m_index { 0 } {
+        }
+
+        Reference operator*() const noexcept {
+            return (*m_array)[m_index];
+        }
+
+        basic_iterator& operator++() noexcept {
+            ++m_index;
+            return *this;
+        }
+
+        basic_iterator operator++(int) noexcept {
+            basic_iterator res = *this;
+            ++m_index;
+            return res;
+        }
+
+        bool operator==(const basic_iterator& rhs) const noexcept {
+            return m_index == rhs.m_index;
+        }
+
+        bool operator!=(const basic_iterator& rhs) const noexcept {
+            return m_index != rhs.m_index;
+        }
+
+    private:
+        friend class packed_flag_array;
+
+        basic_iterator(Array* array, size_type index) noexcept : m_array { array }, m_index { index } {
+        }
+
+        Array* m_array;
+        size_type m_index;
+    };
+
+    using iterator = basic_iterator<packed_flag_array, reference>;
+    using const_iterator = basic_iterator<const packed_flag_array, FlagType>;
+
+    packed_flag_array() : m_words(1), m_size { 0 } {
+    }
+
+    explicit packed_flag_array(size_type count, const FlagType& value = FlagType()) : m_words(1), m_size { 0 } {
+        resize(count, value);
+    }
+
+    packed_flag_array(const FlagType* values, size_type count) : m_words(words_for(count)), m_size { count } {
+        set(0, values, count);
+    }
+
+    size_type size() const noexcept {
+        return m_size;
+    }
+
+    bool empty() const noexcept {
+        return m_size == 0;
+    }
+
+    void reserve(size_type count) {
+        m_words.reserve(words_for(count));
+    }
+
+    void resize(size_type count, const FlagType& value = FlagType()) {
+        const size_type old_size = m_size;
+        m_words.resize(words_for(count));
+        m_size = count;
+        if (count < old_size) {
+            // Keep the bits past the end zero so that growing again starts from empty values.
+            const size_type end = count * bits_per_element;
+            m_words[end / 64] &= (word_type { 1 } << (end % 64)) - 1;
+            for (size_type w = end / 64 + 1; w < m_words.size(); ++w) {
+                m_words[w] = 0;
+            }
+        }
+        for (size_type i = old_size; i < count; ++i) {
+            set(i, value);
+        }
+    }
+
+    void clear() noexcept {
+        m_words.assign(1, 0);
+        m_size = 0;
+    }
+
+    void push_back(const FlagType& value) {
+        if (words_for(m_size + 1) > m_words.size()) {
+            m_words.push_back(0);
+        }
+        set(m_size++, value);
+    }
+
+    FlagType get(size_type index) const noexcept {
+        const size_type pos = index * bits_per_element;
+        return extract(m_words.data() + pos / 64, static_cast<unsigned>(pos % 64));
+    }
+
+    void set(size_type index, const FlagType& value) noexcept {
+        const size_type pos = index * bits_per_element;
+        insert(m_words.data() + pos / 64, static_cast<unsigned>(pos % 64), value);
+    }
+
+    // Unpacks `count` elements starting at `index` into `out`.
+    void get(size_type index, FlagType* out, size_type count) const noexcept {
+        const size_type pos = index * bits_per_element;
+        const word_type* word = m_words.data() + pos / 64;
+        unsigned offset = static_cast<unsigned>(pos % 64);
+        for (size_type i = 0; i < count; ++i) {
+            out[i] = extract(word, offset);
+            advance(word, offset);
+        }
+    }
+
+    // Packs `count` values into the elements starting at `index`.
+    void set(size_type index, const FlagType* values, size_type count) noexcept {
+        const size_type pos = index * bits_per_element;
+        word_type* word = m_words.data() + pos / 64;
+        unsigned offset = static_cast<unsigned>(pos % 64);
+        for (size_type i = 0; i < count; ++i) {
+            insert(word, offset, values[i]);
+            advance(word, offset);
+        }
+    }
+
+    std::vector<FlagType> to_vector() const {
+        std::vector<FlagType> res(m_size);
+        get(0, res.data(), m_size);
+        return res;
+    }
+
+    reference operator[](size_type index) noexcept {
+        return reference(this, index);
+    }
+
+    FlagType operator[](size_type index) const noexcept {
+        return get(index);
+    }
+
+    iterator begin() noexcept {
+        return iterator(this, 0);
+    }
+
+    iterator end() noexcept {
+        return iterator(this, m_size);
+    }
+
+    const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator(this, m_size);
+    }
+
+    // The packed words, including the spare word at the end.
+    const word_type* data() const noexcept {
+        return m_words.data();
+    }
+
+    size_type word_count() const noexcept {
+        return m_words.size();
+    }
+
+    bool operator==(const packed_flag_array& rhs) const noexcept {
+        return m_size == rhs.m_size && m_words == rhs.m_words;
+    }
+
+    bool operator!=(const packed_flag_array& rhs) const noexcept {
+        return !(*this == rhs);
+    }
+
+private:
+    using unsigned_type = typename std::make_unsigned<underlying_type>::type;
+
+    static constexpr word_type s_mask = bits_per_element == 64 ? ~word_type { 0 }
+            : (word_type { 1 } << bits_per_element) - 1;
+
+    std::vector<word_type> m_words;
+    size_type m_size;
+
+    static size_type words_for(size_type count) noexcept {
+        return (count * bits_per_element + 63) / 64 + 1;
+    }
+
+    template<typename Word>
+    static void advance(Word*& word, unsigned& offset) noexcept {
+        offset += bits_per_element;
+        word += offset / 64;
+        offset %= 64;
+    }
+
+    // The high part is shifted in two steps so that offset 0 never shifts by 64.
+    static FlagType extract(const word_type* word, unsigned offset) noexcept {
+        const word_type bits = (word[0] >> offset) | ((word[1] << 1) << (63 - offset));
+        return FlagType::from_underlying_type(static_cast<underlying_type>(bits & s_mask));
+    }
+
+    static void insert(word_type* word, unsigned offset, const FlagType& value) noexcept {
+        const word_type bits = static_cast<unsigned_type>(value.to_underlying_type());
+        word[0] = (word[0] & ~(s_mask << offset)) | (bits << offset);
+        word[1] = (word[1] & ~((s_mask >> 1) >> (63 - offset))) | ((bits >> 1) >> (63 - offset));
+    }
+};
+
+}
+
+#endif /* INCLUDE_STRONG_FLAGS_PACKED_ARRAY_H_ */
@@ -0,0 +1,227 @@
+#ifndef INCLUDE_STRONG_FLAGS_REMAP_H_
+#define INCLUDE_STRONG_FLAGS_REMAP_H_
+
+#include "strong_flags.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#if !defined(STRONG_FLAGS_NO_SIMD) && defined(__BMI2__) && (defined(__x86_64__) || defined(_M_X64))
+#define STRONG_FLAGS_REMAP_BMI2 1
+#include <immintrin.h>
+#endif
+
+namespace strong_flags {
+
+// How a remapper translates a value, chosen at compile time.
+enum class remap_strategy {
+    shift,  // one mask and shift per distinct bit distance
+    bmi2,   // pext gathers the source bits, pdep scatters them; needs an order preserving mapping
+    table,  // the mapped source bits all lie in the low byte and index a 256 entry table
+    bits    // one bit at a time, for wide types
+};
+
+template<std::size_t FromBit, std::size_t ToBit>
+struct bit_mapping {
+    static constexpr std::size_t from = FromBit;
+    static constexpr std::size_t to = ToBit;
+};
+
+// One entry of a remap: source bit FromBit sets target bit ToBit. Bits are the `_bit` constants generated
+// by STRONG_FLAGS_DEFINE_FLAGS.
+template<std::size_t FromBit, std::size_t ToBit>
+constexpr bit_mapping<FromBit, ToBit> map_bit { };
+
+namespace detail {
+
+// Remapping through a table pays off once it replaces more mask and shift pairs than this.
+constexpr std::size_t remap_table_min_groups = 3;
+
+template<std::size_t Count>
+struct remap_plan {
+    std::uint64_t from_mask = 0;
+    std::uint64_t to_mask = 0;
+    std::size_t groups = 0;
+    int shifts[Count + 1] { };
+    std::uint64_t masks[Count + 1] { };
+    bool monotonic = true;
+};
+
+// Groups the mappings by the distance they move their bit, and checks whether sorting them by source
+// bit also sorts them by target bit without repeats, which is what pext followed by pdep computes.
+template<typename... Mappings>
+constexpr remap_plan<sizeof...(Mappings)> make_remap_plan() noexcept {
+    constexpr std::size_t count = sizeof...(Mappings);
+    constexpr std::size_t from[count + 1] = { Mappings::from..., 0 };
+    constexpr std::size_t to[count + 1] = { Mappings::to..., 0 };
+
+    remap_plan<count> plan;
+    for (std::size_t i = 0; i < count; ++i) {
+        // Wide types are remapped bit by bit and need no plan.
+        if (from[i] >= 64 || to[i] >= 64) {
+            plan.monotonic = false;
+            continue;
+        }
+        plan.from_mask |= std::uint64_t { 1 } << from[i];
+        plan.to_mask |= std::uint64_t { 1 } << to[i];
+
+        const int shift = static_cast<int>(to[i]) - static_cast<int>(from[i]);
+        std::size_t g = 0;
+        while (g < plan.groups && plan.shifts[g] != shift) {
+            ++g;
+        }
+        if (g == plan.groups) {
+            plan.shifts[plan.groups++] = shift;
+        }
+        plan.masks[g] |= std::uint64_t { 1 } << from[i];
+
+        for (std::size_t j = 0; j < i; ++j) {
+            if (from[i] == from[j] || to[i] == to[j] || (from[i] < from[j]) != (to[i] < to[j])) {
+                plan.monotonic = false;
+            }
+        }
+    }
+    return plan;
+}
+
+template<typename FlagType>
+constexpr bool remap_wide = !std::is_integral<typename FlagType::underlying_type>::value;
+
+template<typename FlagType>
+constexpr std::uint64_t remap_word(const FlagType& value, std::size_t index) noexcept {
+    if constexpr (remap_wide<FlagType>) {
+        return value.to_underlying_type().word(index);
+    } else {
+        using unsigned_type = typename std::make_unsigned<typename FlagType::underlying_type>::type;
+        return static_cast<unsigned_type>(value.to_underlying_type());
+    }
+}
+
+template<typename... Mappings>
+struct remap_spec {
+    static constexpr auto s_plan = make_remap_plan<Mappings...>();
+
+    static constexpr std::uint64_t shifts(std::uint64_t word) noexcept {
+        return shifts(word, std::make_index_sequence<s_plan.groups> { });
+    }
+
+    template<std::size_t... G>
+    static constexpr std::uint64_t shifts(std::uint64_t word, std::index_sequence<G...>) noexcept {
+        return (std::uint64_t { 0 } | ... | (s_plan.shifts[G] >= 0
+                ? (word & s_plan.masks[G]) << (s_plan.shifts[G] & 63)
+                : (word & s_plan.masks[G]) >> (-s_plan.shifts[G] & 63)));
+    }
+
+    template<typename Word>
+    static constexpr std::array<Word, 256> table() noexcept {
+        std::array<Word, 256> res { };
+        for (std::size_t i = 0; i < res.size(); ++i) {
+            res[i] = static_cast<Word>(shifts(i));
+        }
+        return res;
+    }
+};
+
+// Only instantiated for remappers that use it; entries have the width of the target type.
+template<typename Word, typename... Mappings>
+constexpr std::array<Word, 256> remap_table = remap_spec<Mappings...>::template table<Word>();
+
+template<typename From, typename To, typename... Mappings>
+constexpr remap_strategy choose_remap_strategy() noexcept {
+    constexpr auto plan = remap_spec<Mappings...>::s_plan;
+    if (remap_wide<From> || remap_wide<To>) {
+        return remap_strategy::bits;
+    }
+    if (plan.groups <= 1) {
+        return remap_strategy::shift;
+    }
+#if defined(STRONG_FLAGS_REMAP_BMI2)
+    if (plan.monotonic) {
+        return remap_strategy::bmi2;
+    }
+#endif
+    if (plan.from_mask < 256 && plan.groups >= remap_table_min_groups) {
+        return remap_strategy::table;
+    }
+    return remap_strategy::shift;
+}
+
+}
+
+// Translates values of one flag type into another, bit by bit as declared. Source bits without a mapping
+// are dropped; several source bits may set the same target bit.
+template<typename From, typename To, typename... Mappings>
+class remapper {
+public:
+    using from_type = From;
+    using to_type = To;
+
+    static constexpr remap_strategy strategy = detail::choose_remap_strategy<From, To, Mappings...>();
+
+    constexpr To operator()(const From& value) const noexcept {
+        if constexpr (strategy == remap_strategy::bits) {
+            return remap_bits(value);
+        } else {
+            const std::uint64_t word = detail::remap_word(value, 0);
+            std::uint64_t res = 0;
+            if constexpr (strategy == remap_strategy::table) {
+                using word_type = typename std::make_unsigned<typename To::underlying_type>::type;
+                res = detail::remap_table<word_type, Mappings...>[word & spec::s_plan.from_mask];
+#if defined(STRONG_FLAGS_REMAP_BMI2)
+            } else if constexpr (strategy == remap_strategy::bmi2) {
+                res = detail::is_constant_evaluated() ? spec::shifts(word) : remap_bmi2(word);
+#endif
+            } else {
+                res = spec::shifts(word);
+            }
+            return To::from_underlying_type(static_cast<typename To::underlying_type>(res));
+        }
+    }
+
+    // out[i] = (*this)(in[i]) for every i below count.
+    void apply(const From* in, std::size_t count, To* out) const noexcept {
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = (*this)(in[i]);
+        }
+    }
+
+private:
+    using spec = detail::remap_spec<Mappings...>;
+
+#if defined(STRONG_FLAGS_REMAP_BMI2)
+    static std::uint64_t remap_bmi2(std::uint64_t word) noexcept {
+        return _pdep_u64(_pext_u64(word, spec::s_plan.from_mask), spec::s_plan.to_mask);
+    }
+#endif
+
+    static constexpr To remap_bits(const From& value) noexcept {
+        typename To::underlying_type res { };
+        if constexpr (detail::remap_wide<To>) {
+            ((res.word(Mappings::to / 64) |= (detail::remap_word(value, Mappings::from / 64)
+                    >> (Mappings::from % 64) & 1) << (Mappings::to % 64)), ...);
+        } else {
+            using unsigned_type = typename std::make_unsigned<typename To::underlying_type>::type;
+            unsigned_type bits = 0;
+            ((bits = static_cast<unsigned_type>(bits | (detail::remap_word(value, Mappings::from / 64)
+                    >> (Mappings::from % 64) & 1) << Mappings::to)), ...);
+            res = static_cast<typename To::underlying_type>(bits);
+        }
+        return To::from_underlying_type(res);
+    }
+
+    static_assert(((Mappings::from < From::bit_count) && ...), "Source bit out of range");
+    static_assert(((Mappings::to < To::bit_count) && ...), "Target bit out of range");
+};
+
+// Builds the translation from From to To given by `mappings`, each a map_bit<From::X_bit, To::Y_bit>.
+template<typename From, typename To, std::size_t... FromBits, std::size_t... ToBits>
+constexpr remapper<From, To, bit_mapping<FromBits, ToBits>...> remap(bit_mapping<FromBits, ToBits>...) noexcept {
+    return { };
+}
+
+}
+
+#endif /* INCLUDE_STRONG_FLAGS_REMAP_H_ */
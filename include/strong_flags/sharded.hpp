@@ -0,0 +1,136 @@
+#ifndef INCLUDE_STRONG_FLAGS_SHARDED_H_
+#define INCLUDE_STRONG_FLAGS_SHARDED_H_
+
+#include "strong_flags.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+namespace strong_flags {
+
+namespace detail {
+
+// Destructive interference size; std::hardware_destructive_interference_size is missing from several
+// standard libraries and warns on GCC when used in a header.
+constexpr std::size_t cache_line_size = 64;
+
+// Small dense id per thread, handed out on first use.
+inline std::size_t shard_thread_id() noexcept {
+    static std::atomic<std::size_t> s_next { 0 };
+    thread_local const std::size_t s_id = s_next.fetch_add(1, std::memory_order_relaxed);
+    return s_id;
+}
+
+}
+
+// Sticky flags raised from many threads. Every thread writes to its own cache line, so raising a flag
+// never contends with other writers, and raising a flag that is already set does not write at all.
+// Readers combine the shards; a flag raised concurrently with clear_and_collect() is reported either
+// by that call or by the next one, never lost.
+template<typename FlagType>
+class sharded_flags {
+public:
+    using value_type = FlagType;
+    using bit_type = typename FlagType::bit_type;
+    using underlying_type = typename FlagType::underlying_type;
+
+    // 0 selects one shard per hardware thread. The count is rounded up to a power of two; threads beyond
+    // it share shards, which stays correct and only brings back some contention.
+    explicit sharded_flags(std::size_t shards = 0) : m_mask { round_up(shards) - 1 },
+            m_shards { new shard[m_mask + 1] } {
+    }
+
+    sharded_flags(const sharded_flags&) = delete;
+    sharded_flags& operator=(const sharded_flags&) = delete;
+
+    std::size_t shard_count() const noexcept {
+        return m_mask + 1;
+    }
+
+    void set(bit_type bit, std::memory_order order = std::memory_order_seq_cst) noexcept {
+        set(FlagType::from_bit(bit), order);
+    }
+
+    void set(const FlagType& flags, std::memory_order order = std::memory_order_seq_cst) noexcept {
+        const auto bits = flags.to_underlying_type();
+        auto& word = local().value;
+        if ((word.load(std::memory_order_relaxed) & bits) != bits) {
+            word.fetch_or(bits, order);
+        }
+    }
+
+    // Clears `flags` in every shard.
+    void clear(const FlagType& flags, std::memory_order order = std::memory_order_seq_cst) noexcept {
+        const auto keep = static_cast<underlying_type>(~flags.to_underlying_type());
+        for (std::size_t i = 0; i <= m_mask; ++i) {
+            m_shards[i].value.fetch_and(keep, order);
+        }
+    }
+
+    // Union of all shards.
+    FlagType snapshot(std::memory_order order = std::memory_order_seq_cst) const noexcept {
+        underlying_type res = 0;
+        for (std::size_t i = 0; i <= m_mask; ++i) {
+            res = static_cast<underlying_type>(res | m_shards[i].value.load(order));
+        }
+        return FlagType::from_underlying_type(res);
+    }
+
+    // Resets every shard and returns the union of what they held.
+    FlagType clear_and_collect(std::memory_order order = std::memory_order_seq_cst) noexcept {
+        underlying_type res = 0;
+        for (std::size_t i = 0; i <= m_mask; ++i) {
+            auto& word = m_shards[i].value;
+            if (word.load(std::memory_order_relaxed) != 0) {
+                res = static_cast<underlying_type>(res | word.exchange(0, order));
+            }
+        }
+        return FlagType::from_underlying_type(res);
+    }
+
+    bool test(bit_type bit, std::memory_order order = std::memory_order_seq_cst) const noexcept {
+        return snapshot(order).test(bit);
+    }
+
+    bool test_any(const FlagType& rhs, std::memory_order order = std::memory_order_seq_cst) const noexcept {
+        return snapshot(order).test_any(rhs);
+    }
+
+    bool test_all(const FlagType& rhs, std::memory_order order = std::memory_order_seq_cst) const noexcept {
+        return snapshot(order).test_all(rhs);
+    }
+
+private:
+    struct alignas(detail::cache_line_size) shard {
+        std::atomic<underlying_type> value { 0 };
+    };
+
+    std::size_t m_mask;
+    std::unique_ptr<shard[]> m_shards;
+
+    shard& local() noexcept {
+        return m_shards[detail::shard_thread_id() & m_mask];
+    }
+
+    static std::size_t round_up(std::size_t shards) noexcept {
+        if (shards == 0) {
+            shards = std::thread::hardware_concurrency();
+        }
+        std::size_t res = 1;
+        while (res < shards) {
+            res *= 2;
+        }
+        return res;
+    }
+
+    static_assert(std::is_integral<underlying_type>::value,
+            "strong_flags::sharded_flags requires an integer underlying type");
+    static_assert(sizeof(shard) == detail::cache_line_size, "Shards must fill exactly one cache line");
+};
+
+}
+
+#endif /* INCLUDE_STRONG_FLAGS_SHARDED_H_ */
@@ -5,9 +5,481 @@
 #include <type_traits>
 #include <utility>
 #include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+#if !defined(STRONG_FLAGS_NO_SIMD) && defined(__AVX2__)
+#define STRONG_FLAGS_SIMD_AVX2 1
+#include <immintrin.h>
+#elif !defined(STRONG_FLAGS_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#define STRONG_FLAGS_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// For the integer mutators, which are inlined into their caller even at -O0 so that trace.hpp records the
+// caller's address.
+#if defined(_MSC_VER)
+#define STRONG_FLAGS_FORCE_INLINE __forceinline
+#elif defined(__GNUC__)
+#define STRONG_FLAGS_FORCE_INLINE inline __attribute__((always_inline))
+#else
+#define STRONG_FLAGS_FORCE_INLINE inline
+#endif
 
 namespace strong_flags {
 
+namespace detail {
+
+// Runtime code paths may use intrinsics, constant evaluation must stay on plain word loops.
+// Without compiler support every call takes the plain loops, which compilers auto-vectorize anyway.
+constexpr bool is_constant_evaluated() noexcept {
+#if defined(__cpp_lib_is_constant_evaluated)
+    return std::is_constant_evaluated();
+#elif defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+    return __builtin_is_constant_evaluated();
+#else
+    return true;
+#endif
+#elif defined(__GNUC__) && __GNUC__ >= 9
+    return __builtin_is_constant_evaluated();
+#else
+    return true;
+#endif
+}
+
+template<typename Unsigned>
+constexpr int popcount(Unsigned value) noexcept {
+#if defined(__GNUC__)
+    if constexpr (sizeof(Unsigned) <= sizeof(unsigned int)) {
+        return __builtin_popcount(static_cast<unsigned int>(value));
+    } else if constexpr (sizeof(Unsigned) <= sizeof(unsigned long)) {
+        return __builtin_popcountl(static_cast<unsigned long>(value));
+    } else {
+        return __builtin_popcountll(static_cast<unsigned long long>(value));
+    }
+#else
+    int res = 0;
+    for (; value != 0; value &= value - 1) {
+        ++res;
+    }
+    return res;
+#endif
+}
+
+// Undefined for zero, like the underlying instruction.
+template<typename Unsigned>
+constexpr int countr_zero(Unsigned value) noexcept {
+#if defined(__GNUC__)
+    if constexpr (sizeof(Unsigned) <= sizeof(unsigned int)) {
+        return __builtin_ctz(static_cast<unsigned int>(value));
+    } else if constexpr (sizeof(Unsigned) <= sizeof(unsigned long)) {
+        return __builtin_ctzl(static_cast<unsigned long>(value));
+    } else {
+        return __builtin_ctzll(static_cast<unsigned long long>(value));
+    }
+#else
+    int res = 0;
+    for (; (value & 1) == 0; value >>= 1) {
+        ++res;
+    }
+    return res;
+#endif
+}
+
+// Undefined for zero, like the underlying instruction.
+template<typename Unsigned>
+constexpr int countl_zero(Unsigned value) noexcept {
+#if defined(__GNUC__)
+    if constexpr (sizeof(Unsigned) <= sizeof(unsigned int)) {
+        return __builtin_clz(static_cast<unsigned int>(value))
+                - static_cast<int>((sizeof(unsigned int) - sizeof(Unsigned)) * CHAR_BIT);
+    } else if constexpr (sizeof(Unsigned) <= sizeof(unsigned long)) {
+        return __builtin_clzl(static_cast<unsigned long>(value))
+                - static_cast<int>((sizeof(unsigned long) - sizeof(Unsigned)) * CHAR_BIT);
+    } else {
+        return __builtin_clzll(static_cast<unsigned long long>(value))
+                - static_cast<int>((sizeof(unsigned long long) - sizeof(Unsigned)) * CHAR_BIT);
+    }
+#else
+    int res = 0;
+    for (auto top = static_cast<Unsigned>(1) << (sizeof(Unsigned) * CHAR_BIT - 1); (value & top) == 0; value <<= 1) {
+        ++res;
+    }
+    return res;
+#endif
+}
+
+constexpr std::size_t wide_alignment = 32;
+constexpr std::size_t wide_block_words = wide_alignment / sizeof(std::uint64_t);
+
+// Rounded up to whole 256 bit blocks so kernels never need a tail loop; padding words stay zero.
+constexpr std::size_t wide_word_count(std::size_t bits) noexcept {
+    return (bits + wide_block_words * 64 - 1) / (wide_block_words * 64) * wide_block_words;
+}
+
+template<std::size_t W>
+struct wide_kernels {
+    using word_type = std::uint64_t;
+
+    static_assert(W % wide_block_words == 0, "Word count must be a multiple of the block size");
+
+#if defined(STRONG_FLAGS_SIMD_AVX2)
+    static __m256i load(const word_type* src, std::size_t i) noexcept {
+        return _mm256_load_si256(reinterpret_cast<const __m256i*>(src + i));
+    }
+
+    static void store(word_type* dst, std::size_t i, __m256i value) noexcept {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(dst + i), value);
+    }
+
+    static constexpr std::size_t s_step = 4;
+#elif defined(STRONG_FLAGS_SIMD_SSE2)
+    static __m128i load(const word_type* src, std::size_t i) noexcept {
+        return _mm_load_si128(reinterpret_cast<const __m128i*>(src + i));
+    }
+
+    static void store(word_type* dst, std::size_t i, __m128i value) noexcept {
+        _mm_store_si128(reinterpret_cast<__m128i*>(dst + i), value);
+    }
+
+    static bool is_zero(__m128i value) noexcept {
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(value, _mm_setzero_si128())) == 0xFFFF;
+    }
+
+    static constexpr std::size_t s_step = 2;
+#endif
+
+    static void bit_or(word_type* dst, const word_type* lhs, const word_type* rhs) noexcept {
+#if defined(STRONG_FLAGS_SIMD_AVX2)
+        for (std::size_t i = 0; i < W; i += s_step) {
+            store(dst, i, _mm256_or_si256(load(lhs, i), load(rhs, i)));
+        }
+#elif defined(STRONG_FLAGS_SIMD_SSE2)
+        for (std::size_t i = 0; i < W; i += s_step) {
+            store(dst, i, _mm_or_si128(load(lhs, i), load(rhs, i)));
+        }
+#else
+        for (std::size_t i = 0; i < W; ++i) {
+            dst[i] = lhs[i] | rhs[i];
+        }
+#endif
+    }
+
+    static void bit_and(word_type* dst, const word_type* lhs, const word_type* rhs) noexcept {
+#if defined(STRONG_FLAGS_SIMD_AVX2)
+        for (std::size_t i = 0; i < W; i += s_step) {
+            store(dst, i, _mm256_and_si256(load(lhs, i), load(rhs, i)));
+        }
+#elif defined(STRONG_FLAGS_SIMD_SSE2)
+        for (std::size_t i = 0; i < W; i += s_step) {
+            store(dst, i, _mm_and_si128(load(lhs, i), load(rhs, i)));
+        }
+#else
+        for (std::size_t i = 0; i < W; ++i) {
+            dst[i] = lhs[i] & rhs[i];
+        }
+#endif
+    }
+
+    static void bit_xor(word_type* dst, const word_type* lhs, const word_type* rhs) noexcept {
+#if defined(STRONG_FLAGS_SIMD_AVX2)
+        for (std::size_t i = 0; i < W; i += s_step) {
+            store(dst, i, _mm256_xor_si256(load(lhs, i), load(rhs, i)));
+        }
+#elif defined(STRONG_FLAGS_SIMD_SSE2)
+        for (std::size_t i = 0; i < W; i += s_step) {
+            store(dst, i, _mm_xor_si128(load(lhs, i), load(rhs, i)));
+        }
+#else
+        for (std::size_t i = 0; i < W; ++i) {
+            dst[i] = lhs[i] ^ rhs[i];
+        }
+#endif
+    }
+
+    // dst = lhs & ~rhs
+    static void bit_andnot(word_type* dst, const word_type* lhs, const word_type* rhs) noexcept {
+#if defined(STRONG_FLAGS_SIMD_AVX2)
+        for (std::size_t i = 0; i < W; i += s_step) {
+            store(dst, i, _mm256_andnot_si256(load(rhs, i), load(lhs, i)));
+        }
+#elif defined(STRONG_FLAGS_SIMD_SSE2)
+        for (std::size_t i = 0; i < W; i += s_step) {
+            store(dst, i, _mm_andnot_si128(load(rhs, i), load(lhs, i)));
+        }
+#else
+        for (std::size_t i = 0; i < W; ++i) {
+            dst[i] = lhs[i] & ~rhs[i];
+        }
+#endif
+    }
+
+    // (lhs & rhs) != 0
+    static bool intersects(const word_type* lhs, const word_type* rhs) noexcept {
+#if defined(STRONG_FLAGS_SIMD_AVX2)
+        for (std::size_t i = 0; i < W; i += s_step) {
+            if (!_mm256_testz_si256(load(lhs, i), load(rhs, i))) {
+                return true;
+            }
+        }
+        return false;
+#elif defined(STRONG_FLAGS_SIMD_SSE2)
+        for (std::size_t i = 0; i < W; i += s_step) {
+            if (!is_zero(_mm_and_si128(load(lhs, i), load(rhs, i)))) {
+                return true;
+            }
+        }
+        return false;
+#else
+        word_type acc = 0;
+        for (std::size_t i = 0; i < W; ++i) {
+            acc |= lhs[i] & rhs[i];
+        }
+        return acc != 0;
+#endif
+    }
+
+    // (lhs & rhs) == rhs
+    static bool contains(const word_type* lhs, const word_type* rhs) noexcept {
+#if defined(STRONG_FLAGS_SIMD_AVX2)
+        for (std::size_t i = 0; i < W; i += s_step) {
+            if (!_mm256_testc_si256(load(lhs, i), load(rhs, i))) {
+                return false;
+            }
+        }
+        return true;
+#elif defined(STRONG_FLAGS_SIMD_SSE2)
+        for (std::size_t i = 0; i < W; i += s_step) {
+            if (!is_zero(_mm_andnot_si128(load(lhs, i), load(rhs, i)))) {
+                return false;
+            }
+        }
+        return true;
+#else
+        word_type acc = 0;
+        for (std::size_t i = 0; i < W; ++i) {
+            acc |= rhs[i] & ~lhs[i];
+        }
+        return acc == 0;
+#endif
+    }
+
+    static bool equal(const word_type* lhs, const word_type* rhs) noexcept {
+#if defined(STRONG_FLAGS_SIMD_AVX2)
+        for (std::size_t i = 0; i < W; i += s_step) {
+            const __m256i diff = _mm256_xor_si256(load(lhs, i), load(rhs, i));
+            if (!_mm256_testz_si256(diff, diff)) {
+                return false;
+            }
+        }
+        return true;
+#elif defined(STRONG_FLAGS_SIMD_SSE2)
+        for (std::size_t i = 0; i < W; i += s_step) {
+            if (!is_zero(_mm_xor_si128(load(lhs, i), load(rhs, i)))) {
+                return false;
+            }
+        }
+        return true;
+#else
+        word_type acc = 0;
+        for (std::size_t i = 0; i < W; ++i) {
+            acc |= lhs[i] ^ rhs[i];
+        }
+        return acc == 0;
+#endif
+    }
+};
+
+// Walks the set bits of a single word: countr_zero yields the position, x & (x - 1) drops it.
+template<typename FlagType, typename Unsigned, typename Value>
+class integer_bit_iterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = Value;
+
+    constexpr integer_bit_iterator() noexcept : m_bits { } {
+    }
+
+    constexpr explicit integer_bit_iterator(Unsigned bits) noexcept : m_bits { bits } {
+    }
+
+    constexpr Value operator*() const noexcept {
+        if constexpr (std::is_same<Value, FlagType>::value) {
+            return FlagType::from_underlying_type(
+                    static_cast<typename FlagType::underlying_type>(m_bits & static_cast<Unsigned>(0U - m_bits)));
+        } else {
+            return static_cast<Value>(countr_zero(m_bits));
+        }
+    }
+
+    constexpr integer_bit_iterator& operator++() noexcept {
+        m_bits = static_cast<Unsigned>(m_bits & (m_bits - 1U));
+        return *this;
+    }
+
+    constexpr integer_bit_iterator operator++(int) noexcept {
+        auto res = *this;
+        ++*this;
+        return res;
+    }
+
+    constexpr bool operator==(const integer_bit_iterator& rhs) const noexcept {
+        return m_bits == rhs.m_bits;
+    }
+
+    constexpr bool operator!=(const integer_bit_iterator& rhs) const noexcept {
+        return m_bits != rhs.m_bits;
+    }
+
+private:
+    Unsigned m_bits;
+};
+
+template<typename FlagType, std::size_t W, typename Value>
+class wide_bit_iterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = Value;
+
+    constexpr wide_bit_iterator() noexcept : m_words { }, m_index { W }, m_current { } {
+    }
+
+    constexpr wide_bit_iterator(const std::uint64_t* words, std::size_t index) noexcept
+            : m_words { words }, m_index { index }, m_current { index < W ? words[index] : 0 } {
+        skip_empty();
+    }
+
+    constexpr Value operator*() const noexcept {
+        const auto bit = m_index * 64 + static_cast<std::size_t>(countr_zero(m_current));
+        if constexpr (std::is_same<Value, FlagType>::value) {
+            return FlagType::from_bit(bit);
+        } else {
+            return static_cast<Value>(bit);
+        }
+    }
+
+    constexpr wide_bit_iterator& operator++() noexcept {
+        m_current &= m_current - 1;
+        skip_empty();
+        return *this;
+    }
+
+    constexpr wide_bit_iterator operator++(int) noexcept {
+        auto res = *this;
+        ++*this;
+        return res;
+    }
+
+    constexpr bool operator==(const wide_bit_iterator& rhs) const noexcept {
+        return m_index == rhs.m_index && m_current == rhs.m_current;
+    }
+
+    constexpr bool operator!=(const wide_bit_iterator& rhs) const noexcept {
+        return !(*this == rhs);
+    }
+
+private:
+    const std::uint64_t* m_words;
+    std::size_t m_index;
+    std::uint64_t m_current;
+
+    constexpr void skip_empty() noexcept {
+        while (m_current == 0 && m_index < W) {
+            if (++m_index < W) {
+                m_current = m_words[m_index];
+            }
+        }
+    }
+};
+
+// Grants extension headers access to the stored value and the mask of a flag type.
+struct flag_access;
+
+// Defined in trace.hpp, which every traced type needs.
+template<typename FlagType, typename Underlying>
+void trace_record(Underlying old_value, Underlying new_value) noexcept;
+
+}
+
+// Selects flag types whose mutations are recorded by trace.hpp; see STRONG_FLAGS_TRACE_FLAGS. Building with
+// STRONG_FLAGS_TRACE_ALL traces every flag type with an integer underlying type. The trait is first used
+// when a mutator is instantiated, so it must be specialized before the type is modified.
+template<typename FlagType>
+struct traced : std::integral_constant<bool,
+#if defined(STRONG_FLAGS_TRACE_ALL)
+        true
+#else
+        false
+#endif
+        > {
+};
+
+namespace detail {
+
+// Lives for the duration of one mutating member and records the value before and after it. Untraced
+// types get the empty primary template, so mutators compile exactly as without tracing.
+template<typename FlagType, typename Underlying, bool = traced<FlagType>::value>
+class trace_guard {
+public:
+    explicit trace_guard(const Underlying&) noexcept {
+    }
+};
+
+template<typename FlagType, typename Underlying>
+class trace_guard<FlagType, Underlying, true> {
+public:
+    STRONG_FLAGS_FORCE_INLINE explicit trace_guard(const Underlying& value) noexcept
+            : m_value { value }, m_old { value } {
+    }
+
+    trace_guard(const trace_guard&) = delete;
+    trace_guard& operator=(const trace_guard&) = delete;
+
+    STRONG_FLAGS_FORCE_INLINE ~trace_guard() {
+        trace_record<FlagType>(m_old, m_value);
+    }
+
+private:
+    const Underlying& m_value;
+    Underlying m_old;
+};
+
+}
+
+// Holds a copy of the value, so iterating over temporaries such as (a | b).bits() is safe.
+template<typename Iterator, typename Storage>
+class bit_range {
+public:
+    using iterator = Iterator;
+    using const_iterator = Iterator;
+
+    constexpr explicit bit_range(const Storage& value) noexcept : m_value { value } {
+    }
+
+    constexpr iterator begin() const noexcept {
+        if constexpr (std::is_integral<Storage>::value) {
+            return iterator { m_value };
+        } else {
+            return iterator { m_value.data(), 0 };
+        }
+    }
+
+    constexpr iterator end() const noexcept {
+        return iterator { };
+    }
+
+private:
+    Storage m_value;
+};
 
 template<typename FlagType, typename Integer, std::size_t N>
 class impl {
@@ -16,6 +488,12 @@ public:
     using this_type = impl<FlagType, Integer, N>;
     using bit_type = std::size_t;
     using underlying_type = Integer;
+    using bit_range_type = bit_range<detail::integer_bit_iterator<FlagType,
+            typename std::make_unsigned<Integer>::type, bit_type>, typename std::make_unsigned<Integer>::type>;
+    using flag_range_type = bit_range<detail::integer_bit_iterator<FlagType,
+            typename std::make_unsigned<Integer>::type, FlagType>, typename std::make_unsigned<Integer>::type>;
+
+    static constexpr bit_type bit_count = N;
 
     constexpr impl() noexcept : m_value { } {
     }
@@ -59,44 +537,81 @@ public:
         return (m_value & other.m_value) == other.m_value;
     }
 
-    FlagType& set(bit_type bit) noexcept {
+    constexpr bool empty() const noexcept {
+        return m_value == 0;
+    }
+
+    constexpr bool any() const noexcept {
+        return m_value != 0;
+    }
+
+    constexpr std::size_t count() const noexcept {
+        return static_cast<std::size_t>(detail::popcount(static_cast<unsigned_type>(m_value)));
+    }
+
+    // Returns N if no flag is set.
+    constexpr bit_type lowest_bit() const noexcept {
+        return m_value == 0 ? N : static_cast<bit_type>(detail::countr_zero(static_cast<unsigned_type>(m_value)));
+    }
+
+    // Returns N if no flag is set.
+    constexpr bit_type highest_bit() const noexcept {
+        return m_value == 0 ? N
+                : s_bitsize - 1 - static_cast<bit_type>(detail::countl_zero(static_cast<unsigned_type>(m_value)));
+    }
+
+    constexpr bit_range_type bits() const noexcept {
+        return bit_range_type { static_cast<unsigned_type>(m_value) };
+    }
+
+    constexpr flag_range_type flags() const noexcept {
+        return flag_range_type { static_cast<unsigned_type>(m_value) };
+    }
+
+    STRONG_FLAGS_FORCE_INLINE FlagType& set(bit_type bit) noexcept {
+        detail::trace_guard<FlagType, Integer> guard { m_value };
         m_value |= (s_one << bit) & s_mask;
         return *static_cast<FlagType*>(this);
     }
 
-    FlagType& set(const FlagType& rhs) noexcept {
+    STRONG_FLAGS_FORCE_INLINE FlagType& set(const FlagType& rhs) noexcept {
         return *this |= rhs;
     }
 
-    FlagType& clear(bit_type bit) noexcept {
+    STRONG_FLAGS_FORCE_INLINE FlagType& clear(bit_type bit) noexcept {
+        detail::trace_guard<FlagType, Integer> guard { m_value };
         m_value &= ~(s_one << bit);
         return *static_cast<FlagType*>(this);
     }
 
-    FlagType& clear(const FlagType& rhs) noexcept {
+    STRONG_FLAGS_FORCE_INLINE FlagType& clear(const FlagType& rhs) noexcept {
         return *this &= (~rhs);
     }
 
-    FlagType& toggle(bit_type bit) noexcept {
+    STRONG_FLAGS_FORCE_INLINE FlagType& toggle(bit_type bit) noexcept {
+        detail::trace_guard<FlagType, Integer> guard { m_value };
         m_value = s_mask & (m_value ^ (s_one << bit));
         return *static_cast<FlagType*>(this);
     }
 
-    FlagType& toggle(const FlagType& rhs) noexcept {
+    STRONG_FLAGS_FORCE_INLINE FlagType& toggle(const FlagType& rhs) noexcept {
         return *this ^= rhs;
     }
 
-    FlagType& operator|=(const FlagType& rhs) noexcept {
+    STRONG_FLAGS_FORCE_INLINE FlagType& operator|=(const FlagType& rhs) noexcept {
+        detail::trace_guard<FlagType, Integer> guard { m_value };
         m_value |= static_cast<const this_type&>(rhs).m_value;
         return *static_cast<FlagType*>(this);
     }
 
-    FlagType& operator&=(const FlagType& rhs) noexcept {
+    STRONG_FLAGS_FORCE_INLINE FlagType& operator&=(const FlagType& rhs) noexcept {
+        detail::trace_guard<FlagType, Integer> guard { m_value };
         m_value &= static_cast<const this_type&>(rhs).m_value;
         return *static_cast<FlagType*>(this);
     }
 
-    FlagType& operator^=(const FlagType& rhs) noexcept {
+    STRONG_FLAGS_FORCE_INLINE FlagType& operator^=(const FlagType& rhs) noexcept {
+        detail::trace_guard<FlagType, Integer> guard { m_value };
         m_value ^= static_cast<const this_type&>(rhs).m_value;
         return *static_cast<FlagType*>(this);
     }
@@ -118,239 +633,758 @@ public:
     }
 
 private:
+    friend struct detail::flag_access;
+
     Integer m_value;
 
     using unsigned_type = typename std::make_unsigned<underlying_type>::type;
 
     static constexpr bit_type s_bitsize = sizeof(underlying_type) * CHAR_BIT;
-    static constexpr auto s_mask = static_cast<underlying_type>((~static_cast<unsigned_type>(0)) >> (s_bitsize - N));
+    static constexpr auto s_mask = static_cast<underlying_type>(
+            static_cast<unsigned_type>(~static_cast<unsigned_type>(0)) >> (s_bitsize - N));
     static constexpr auto s_one = static_cast<underlying_type>(1);
 
     static_assert(std::is_integral<Integer>::value,
-            "Underlying type must be integer type or bitset type");
+            "Underlying type must be integer type or strong_flags::wide");
     static_assert(s_bitsize >= N, "Integer type too small");
 };
 
-template<typename FlagType, template<std::size_t> typename Bitset, std::size_t N>
-class impl<FlagType, Bitset<N>, N> {
+template<std::size_t N>
+class wide_bitset {
 public:
-    using this_type = impl<FlagType, Bitset<N>, N>;
+    using word_type = std::uint64_t;
+
+    static constexpr std::size_t word_bits = sizeof(word_type) * CHAR_BIT;
+    static constexpr std::size_t word_count = detail::wide_word_count(N);
+
+    constexpr wide_bitset() noexcept : m_words { } {
+    }
+
+    constexpr word_type word(std::size_t index) const noexcept {
+        return m_words[index];
+    }
+
+    constexpr word_type& word(std::size_t index) noexcept {
+        return m_words[index];
+    }
+
+    constexpr const word_type* data() const noexcept {
+        return m_words;
+    }
+
+    constexpr word_type* data() noexcept {
+        return m_words;
+    }
+
+    constexpr bool operator==(const wide_bitset& rhs) const noexcept {
+        if (detail::is_constant_evaluated()) {
+            for (std::size_t i = 0; i < word_count; ++i) {
+                if (m_words[i] != rhs.m_words[i]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        return detail::wide_kernels<word_count>::equal(m_words, rhs.m_words);
+    }
+
+    constexpr bool operator!=(const wide_bitset& rhs) const noexcept {
+        return !(*this == rhs);
+    }
+
+private:
+    alignas(detail::wide_alignment) word_type m_words[word_count];
+};
+
+template<typename FlagType, std::size_t N>
+class impl<FlagType, wide_bitset<N>, N> {
+public:
+    using this_type = impl<FlagType, wide_bitset<N>, N>;
     using bit_type = std::size_t;
-    using underlying_type = Bitset<N>;
+    using underlying_type = wide_bitset<N>;
+    using bit_range_type = bit_range<detail::wide_bit_iterator<FlagType, wide_bitset<N>::word_count, bit_type>,
+            wide_bitset<N>>;
+    using flag_range_type = bit_range<detail::wide_bit_iterator<FlagType, wide_bitset<N>::word_count, FlagType>,
+            wide_bitset<N>>;
+
+    static constexpr bit_type bit_count = N;
 
     constexpr impl() noexcept : m_value { } {
     }
 
-    constexpr impl(const FlagType& rhs) noexcept : m_value { static_cast<const this_type&>(rhs).m_value } {
+    static constexpr FlagType from_underlying_type(const underlying_type& value) noexcept {
+        FlagType res;
+        static_cast<this_type&>(res).assign_and(value, s_mask);
+        return res;
     }
 
-    constexpr bool operator==(const FlagType& rhs) noexcept {
+    constexpr const underlying_type& to_underlying_type() const noexcept {
+        return m_value;
+    }
+
+    constexpr explicit operator underlying_type() const noexcept {
+        return m_value;
+    }
+
+    static constexpr FlagType from_bit(bit_type bit) noexcept {
+        FlagType res;
+        if (bit < N) {
+            static_cast<this_type&>(res).m_value.word(word_index(bit)) = word_bit(bit);
+        }
+        return res;
+    }
+
+    constexpr bool operator==(const FlagType& rhs) const noexcept {
         return m_value == static_cast<const this_type&>(rhs).m_value;
     }
 
-    constexpr bool operator!=(const FlagType& rhs) noexcept {
+    constexpr bool operator!=(const FlagType& rhs) const noexcept {
         return m_value != static_cast<const this_type&>(rhs).m_value;
     }
 
-    constexpr bool test(bit_type bit) {
-        return m_value[bit];
+    constexpr bool test(bit_type bit) const noexcept {
+        return bit < N && (m_value.word(word_index(bit)) & word_bit(bit)) != 0;
+    }
+
+    constexpr bool test_any(const FlagType& rhs) const noexcept {
+        const auto& other = static_cast<const this_type&>(rhs).m_value;
+        if (detail::is_constant_evaluated()) {
+            for (std::size_t i = 0; i < s_words; ++i) {
+                if ((m_value.word(i) & other.word(i)) != 0) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        return kernels::intersects(m_value.data(), other.data());
+    }
+
+    constexpr bool test_all(const FlagType& rhs) const noexcept {
+        const auto& other = static_cast<const this_type&>(rhs).m_value;
+        if (detail::is_constant_evaluated()) {
+            for (std::size_t i = 0; i < s_words; ++i) {
+                if ((m_value.word(i) & other.word(i)) != other.word(i)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        return kernels::contains(m_value.data(), other.data());
+    }
+
+    constexpr bool empty() const noexcept {
+        if (detail::is_constant_evaluated()) {
+            for (std::size_t i = 0; i < s_words; ++i) {
+                if (m_value.word(i) != 0) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        return !kernels::intersects(m_value.data(), m_value.data());
+    }
+
+    constexpr bool any() const noexcept {
+        return !empty();
+    }
+
+    constexpr std::size_t count() const noexcept {
+        std::size_t res = 0;
+        for (std::size_t i = 0; i < s_words; ++i) {
+            res += static_cast<std::size_t>(detail::popcount(m_value.word(i)));
+        }
+        return res;
+    }
+
+    // Returns N if no flag is set.
+    constexpr bit_type lowest_bit() const noexcept {
+        for (std::size_t i = 0; i < s_words; ++i) {
+            if (m_value.word(i) != 0) {
+                return i * s_word_bits + static_cast<bit_type>(detail::countr_zero(m_value.word(i)));
+            }
+        }
+        return N;
+    }
+
+    // Returns N if no flag is set.
+    constexpr bit_type highest_bit() const noexcept {
+        for (std::size_t i = s_words; i-- > 0;) {
+            if (m_value.word(i) != 0) {
+                return (i + 1) * s_word_bits - 1 - static_cast<bit_type>(detail::countl_zero(m_value.word(i)));
+            }
+        }
+        return N;
     }
 
-    constexpr bool test_any(const FlagType& rhs) noexcept {
-        return (m_value & static_cast<const this_type&>(rhs).m_value).any();
+    constexpr bit_range_type bits() const noexcept {
+        return bit_range_type { m_value };
     }
 
-    constexpr bool test_all(const FlagType& rhs) noexcept {
-        return (m_value & static_cast<const this_type&>(rhs).m_value).all();
+    constexpr flag_range_type flags() const noexcept {
+        return flag_range_type { m_value };
+    }
+
+    FlagType& set(bit_type bit) noexcept {
+        if (bit < N) {
+            m_value.word(word_index(bit)) |= word_bit(bit);
+        }
+        return *static_cast<FlagType*>(this);
+    }
+
+    FlagType& set(const FlagType& rhs) noexcept {
+        return *this |= rhs;
+    }
+
+    FlagType& clear(bit_type bit) noexcept {
+        if (bit < N) {
+            m_value.word(word_index(bit)) &= ~word_bit(bit);
+        }
+        return *static_cast<FlagType*>(this);
+    }
+
+    FlagType& clear(const FlagType& rhs) noexcept {
+        kernels::bit_andnot(m_value.data(), m_value.data(), static_cast<const this_type&>(rhs).m_value.data());
+        return *static_cast<FlagType*>(this);
+    }
+
+    FlagType& toggle(bit_type bit) noexcept {
+        if (bit < N) {
+            m_value.word(word_index(bit)) ^= word_bit(bit);
+        }
+        return *static_cast<FlagType*>(this);
+    }
+
+    FlagType& toggle(const FlagType& rhs) noexcept {
+        return *this ^= rhs;
     }
 
     FlagType& operator|=(const FlagType& rhs) noexcept {
-        m_value |= static_cast<const this_type&>(rhs).m_value;
+        kernels::bit_or(m_value.data(), m_value.data(), static_cast<const this_type&>(rhs).m_value.data());
         return *static_cast<FlagType*>(this);
     }
 
     FlagType& operator&=(const FlagType& rhs) noexcept {
-        m_value |= static_cast<const this_type&>(rhs).m_value;
+        kernels::bit_and(m_value.data(), m_value.data(), static_cast<const this_type&>(rhs).m_value.data());
         return *static_cast<FlagType*>(this);
     }
 
     FlagType& operator^=(const FlagType& rhs) noexcept {
-        m_value |= static_cast<const this_type&>(rhs).m_value;
+        kernels::bit_xor(m_value.data(), m_value.data(), static_cast<const this_type&>(rhs).m_value.data());
         return *static_cast<FlagType*>(this);
     }
 
-    FlagType operator~() noexcept {
-        return from_underlying_type(~m_value);
+    constexpr FlagType operator|(const FlagType& rhs) const noexcept {
+        FlagType res;
+        static_cast<this_type&>(res).assign_or(m_value, static_cast<const this_type&>(rhs).m_value);
+        return res;
+    }
+
+    constexpr FlagType operator&(const FlagType& rhs) const noexcept {
+        FlagType res;
+        static_cast<this_type&>(res).assign_and(m_value, static_cast<const this_type&>(rhs).m_value);
+        return res;
+    }
+
+    constexpr FlagType operator^(const FlagType& rhs) const noexcept {
+        FlagType res;
+        static_cast<this_type&>(res).assign_xor(m_value, static_cast<const this_type&>(rhs).m_value);
+        return res;
+    }
+
+    constexpr FlagType operator~() const noexcept {
+        FlagType res;
+        static_cast<this_type&>(res).assign_not(m_value);
+        return res;
     }
 
 private:
-    Bitset<N> m_value;
+    friend struct detail::flag_access;
+
+    using word_type = typename underlying_type::word_type;
+    using kernels = detail::wide_kernels<underlying_type::word_count>;
+
+    underlying_type m_value;
+
+    static constexpr std::size_t s_words = underlying_type::word_count;
+    static constexpr std::size_t s_word_bits = underlying_type::word_bits;
+
+    static constexpr std::size_t word_index(bit_type bit) noexcept {
+        return bit / s_word_bits;
+    }
+
+    static constexpr word_type word_bit(bit_type bit) noexcept {
+        return static_cast<word_type>(1) << (bit % s_word_bits);
+    }
+
+    static constexpr underlying_type make_mask() noexcept {
+        underlying_type mask;
+        for (std::size_t i = 0; i < N / s_word_bits; ++i) {
+            mask.word(i) = ~static_cast<word_type>(0);
+        }
+        if (N % s_word_bits != 0) {
+            mask.word(N / s_word_bits) = ~static_cast<word_type>(0) >> (s_word_bits - N % s_word_bits);
+        }
+        return mask;
+    }
+
+    static constexpr underlying_type s_mask = make_mask();
+
+    constexpr void assign_or(const underlying_type& lhs, const underlying_type& rhs) noexcept {
+        if (detail::is_constant_evaluated()) {
+            for (std::size_t i = 0; i < s_words; ++i) {
+                m_value.word(i) = lhs.word(i) | rhs.word(i);
+            }
+        } else {
+            kernels::bit_or(m_value.data(), lhs.data(), rhs.data());
+        }
+    }
+
+    constexpr void assign_and(const underlying_type& lhs, const underlying_type& rhs) noexcept {
+        if (detail::is_constant_evaluated()) {
+            for (std::size_t i = 0; i < s_words; ++i) {
+                m_value.word(i) = lhs.word(i) & rhs.word(i);
+            }
+        } else {
+            kernels::bit_and(m_value.data(), lhs.data(), rhs.data());
+        }
+    }
+
+    constexpr void assign_xor(const underlying_type& lhs, const underlying_type& rhs) noexcept {
+        if (detail::is_constant_evaluated()) {
+            for (std::size_t i = 0; i < s_words; ++i) {
+                m_value.word(i) = lhs.word(i) ^ rhs.word(i);
+            }
+        } else {
+            kernels::bit_xor(m_value.data(), lhs.data(), rhs.data());
+        }
+    }
+
+    constexpr void assign_not(const underlying_type& value) noexcept {
+        if (detail::is_constant_evaluated()) {
+            for (std::size_t i = 0; i < s_words; ++i) {
+                m_value.word(i) = ~value.word(i) & s_mask.word(i);
+            }
+        } else {
+            kernels::bit_andnot(m_value.data(), s_mask.data(), value.data());
+        }
+    }
 
-    static_assert(std::is_base_of<this_type, FlagType>::value, "Flagtype should derive from implementation class");
+    static_assert(N > 0, "Flag type must have at least one flag");
 };
 
-}
-#define STRONG_FLAGS_ARG_COUNT_IMPL(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17,     \
-    _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39,   \
-    _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61,   \
-    _62, _63, _64, count, ...) count
+// Flag identifiers in bit order, split out of the stringized macro argument list.
+template<std::size_t N>
+class name_table {
+public:
+    // One pass over the characters: this runs in constant evaluation for every flag type, where library
+    // calls such as find() and substr() are much slower than plain indexing.
+    constexpr explicit name_table(std::string_view list) noexcept : m_names { } {
+        const char* data = list.data();
+        std::size_t begin = 0;
+        for (std::size_t pos = 0, n = 0; n < N && pos <= list.size(); ++pos) {
+            if (pos == list.size() || data[pos] == ',') {
+                std::size_t first = begin;
+                std::size_t last = pos;
+                while (first < last && data[first] == ' ') {
+                    ++first;
+                }
+                while (last > first && data[last - 1] == ' ') {
+                    --last;
+                }
+                m_names[n++] = std::string_view(data + first, last - first);
+                begin = pos + 1;
+            }
+        }
+    }
 
-#define STRONG_FLAGS_ARG_COUNT(...)                                                                                 \
-    STRONG_FLAGS_ARG_COUNT_IMPL(__VA_ARGS__, 64, 63, 62, 61, 60, 59, 58, 57, 56, 55, 54, 53, 52, 51, 50, 49, 48,    \
-            47, 46, 45, 44, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, \
-            21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1)
+    constexpr std::string_view operator[](std::size_t bit) const noexcept {
+        return m_names[bit];
+    }
+
+    constexpr std::size_t size() const noexcept {
+        return N;
+    }
+
+    constexpr const std::string_view* begin() const noexcept {
+        return m_names;
+    }
+
+    constexpr const std::string_view* end() const noexcept {
+        return m_names + N;
+    }
 
+private:
+    std::string_view m_names[N];
+};
+
+struct wide {
+};
+
+template<typename Underlying, std::size_t N>
+struct storage {
+    using type = Underlying;
+};
+
+template<std::size_t N>
+struct storage<wide, N> {
+    using type = wide_bitset<N>;
+};
+
+// Selects the smallest unsigned integer holding N flags, wide_bitset beyond 64.
+struct minimal {
+};
+
+template<std::size_t N>
+struct storage<minimal, N> {
+    using type = typename std::conditional<N <= 8, std::uint8_t,
+            typename std::conditional<N <= 16, std::uint16_t,
+            typename std::conditional<N <= 32, std::uint32_t,
+            typename std::conditional<N <= 64, std::uint64_t, wide_bitset<N>>::type>::type>::type>::type;
+};
+
+template<typename Underlying, std::size_t N>
+using storage_t = typename storage<Underlying, N>::type;
+
+}
 #define STRONG_FLAGS_PASTE_IMPL(a, b) a##b
 
 #define STRONG_FLAGS_PASTE(a, b) STRONG_FLAGS_PASTE_IMPL(a, b)
 
+// Flag lists are walked in levels of 16, 16, 32, 64, 128, 256 and 512 names. The list is padded with
+// STRONG_FLAGS_END markers, which expand to nothing; a level that continues appends enough markers for the
+// next, larger one, and the walk stops at the first level that would start on a marker. Each level hands
+// the names behind it on to the next, so the preprocessor rescans the tail once per level. With the level
+// size doubling that is about log2(n / 8) rescans for n names, n log n work in total. The levels bound a
+// list at 1024 names.
+#define STRONG_FLAGS_SECOND(a, b, ...) b
+#define STRONG_FLAGS_END_PROBE_STRONG_FLAGS_END ~, 1
+#define STRONG_FLAGS_IS_END_IMPL(...) STRONG_FLAGS_SECOND(__VA_ARGS__, 0, ~)
+#define STRONG_FLAGS_IS_END(x) STRONG_FLAGS_IS_END_IMPL(STRONG_FLAGS_PASTE(STRONG_FLAGS_END_PROBE_, x))
+
+#define STRONG_FLAGS_APPLY_0(macro, x) macro(x)
+#define STRONG_FLAGS_APPLY_1(macro, x)
+#define STRONG_FLAGS_APPLY(macro, x) STRONG_FLAGS_PASTE(STRONG_FLAGS_APPLY_, STRONG_FLAGS_IS_END(x))(macro, x)
+
+#define STRONG_FLAGS_APPLY_16(m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16)             \
+    STRONG_FLAGS_APPLY(m, _1) STRONG_FLAGS_APPLY(m, _2) STRONG_FLAGS_APPLY(m, _3) STRONG_FLAGS_APPLY(m, _4)         \
+    STRONG_FLAGS_APPLY(m, _5) STRONG_FLAGS_APPLY(m, _6) STRONG_FLAGS_APPLY(m, _7) STRONG_FLAGS_APPLY(m, _8)         \
+    STRONG_FLAGS_APPLY(m, _9) STRONG_FLAGS_APPLY(m, _10) STRONG_FLAGS_APPLY(m, _11) STRONG_FLAGS_APPLY(m, _12)      \
+    STRONG_FLAGS_APPLY(m, _13) STRONG_FLAGS_APPLY(m, _14) STRONG_FLAGS_APPLY(m, _15) STRONG_FLAGS_APPLY(m, _16)
+
+#define STRONG_FLAGS_APPLY_32(m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18,   \
+            _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32)                                   \
+    STRONG_FLAGS_APPLY_16(m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16)                 \
+    STRONG_FLAGS_APPLY_16(m, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32)
+
+#define STRONG_FLAGS_APPLY_64(m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18,   \
+            _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38,     \
+            _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58,     \
+            _59, _60, _61, _62, _63, _64)                                                                           \
+    STRONG_FLAGS_APPLY_32(m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19,  \
+            _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32)                                        \
+    STRONG_FLAGS_APPLY_32(m, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49,   \
+            _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61, _62, _63, _64)
+
+#define STRONG_FLAGS_APPLY_128(m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18,  \
+            _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38,     \
+            _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58,     \
+            _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78,     \
+            _79, _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98,     \
+            _99, _100, _101, _102, _103, _104, _105, _106, _107, _108, _109, _110, _111, _112, _113, _114, _115,    \
+            _116, _117, _118, _119, _120, _121, _122, _123, _124, _125, _126, _127, _128)                           \
+    STRONG_FLAGS_APPLY_64(m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19,  \
+            _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39,     \
+            _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59,     \
+            _60, _61, _62, _63, _64)                                                                                \
+    STRONG_FLAGS_APPLY_64(m, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78, _79, _80, _81,   \
+            _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99, _100, _101,   \
+            _102, _103, _104, _105, _106, _107, _108, _109, _110, _111, _112, _113, _114, _115, _116, _117, _118,   \
+            _119, _120, _121, _122, _123, _124, _125, _126, _127, _128)
+
+#define STRONG_FLAGS_APPLY_256(m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18,  \
+            _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38,     \
+            _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58,     \
+            _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78,     \
+            _79, _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98,     \
+            _99, _100, _101, _102, _103, _104, _105, _106, _107, _108, _109, _110, _111, _112, _113, _114, _115,    \
+            _116, _117, _118, _119, _120, _121, _122, _123, _124, _125, _126, _127, _128, _129, _130, _131, _132,   \
+            _133, _134, _135, _136, _137, _138, _139, _140, _141, _142, _143, _144, _145, _146, _147, _148, _149,   \
+            _150, _151, _152, _153, _154, _155, _156, _157, _158, _159, _160, _161, _162, _163, _164, _165, _166,   \
+            _167, _168, _169, _170, _171, _172, _173, _174, _175, _176, _177, _178, _179, _180, _181, _182, _183,   \
+            _184, _185, _186, _187, _188, _189, _190, _191, _192, _193, _194, _195, _196, _197, _198, _199, _200,   \
+            _201, _202, _203, _204, _205, _206, _207, _208, _209, _210, _211, _212, _213, _214, _215, _216, _217,   \
+            _218, _219, _220, _221, _222, _223, _224, _225, _226, _227, _228, _229, _230, _231, _232, _233, _234,   \
+            _235, _236, _237, _238, _239, _240, _241, _242, _243, _244, _245, _246, _247, _248, _249, _250, _251,   \
+            _252, _253, _254, _255, _256)                                                                           \
+    STRONG_FLAGS_APPLY_128(m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, \
+            _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39,     \
+            _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59,     \
+            _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78, _79,     \
+            _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99,     \
+            _100, _101, _102, _103, _104, _105, _106, _107, _108, _109, _110, _111, _112, _113, _114, _115, _116,   \
+            _117, _118, _119, _120, _121, _122, _123, _124, _125, _126, _127, _128)                                 \
+    STRONG_FLAGS_APPLY_128(m, _129, _130, _131, _132, _133, _134, _135, _136, _137, _138, _139, _140, _141, _142,   \
+            _143, _144, _145, _146, _147, _148, _149, _150, _151, _152, _153, _154, _155, _156, _157, _158, _159,   \
+            _160, _161, _162, _163, _164, _165, _166, _167, _168, _169, _170, _171, _172, _173, _174, _175, _176,   \
+            _177, _178, _179, _180, _181, _182, _183, _184, _185, _186, _187, _188, _189, _190, _191, _192, _193,   \
+            _194, _195, _196, _197, _198, _199, _200, _201, _202, _203, _204, _205, _206, _207, _208, _209, _210,   \
+            _211, _212, _213, _214, _215, _216, _217, _218, _219, _220, _221, _222, _223, _224, _225, _226, _227,   \
+            _228, _229, _230, _231, _232, _233, _234, _235, _236, _237, _238, _239, _240, _241, _242, _243, _244,   \
+            _245, _246, _247, _248, _249, _250, _251, _252, _253, _254, _255, _256)
+
+#define STRONG_FLAGS_APPLY_512(m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18,  \
+            _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38,     \
+            _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58,     \
+            _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78,     \
+            _79, _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98,     \
+            _99, _100, _101, _102, _103, _104, _105, _106, _107, _108, _109, _110, _111, _112, _113, _114, _115,    \
+            _116, _117, _118, _119, _120, _121, _122, _123, _124, _125, _126, _127, _128, _129, _130, _131, _132,   \
+            _133, _134, _135, _136, _137, _138, _139, _140, _141, _142, _143, _144, _145, _146, _147, _148, _149,   \
+            _150, _151, _152, _153, _154, _155, _156, _157, _158, _159, _160, _161, _162, _163, _164, _165, _166,   \
+            _167, _168, _169, _170, _171, _172, _173, _174, _175, _176, _177, _178, _179, _180, _181, _182, _183,   \
+            _184, _185, _186, _187, _188, _189, _190, _191, _192, _193, _194, _195, _196, _197, _198, _199, _200,   \
+            _201, _202, _203, _204, _205, _206, _207, _208, _209, _210, _211, _212, _213, _214, _215, _216, _217,   \
+            _218, _219, _220, _221, _222, _223, _224, _225, _226, _227, _228, _229, _230, _231, _232, _233, _234,   \
+            _235, _236, _237, _238, _239, _240, _241, _242, _243, _244, _245, _246, _247, _248, _249, _250, _251,   \
+            _252, _253, _254, _255, _256, _257, _258, _259, _260, _261, _262, _263, _264, _265, _266, _267, _268,   \
+            _269, _270, _271, _272, _273, _274, _275, _276, _277, _278, _279, _280, _281, _282, _283, _284, _285,   \
+            _286, _287, _288, _289, _290, _291, _292, _293, _294, _295, _296, _297, _298, _299, _300, _301, _302,   \
+            _303, _304, _305, _306, _307, _308, _309, _310, _311, _312, _313, _314, _315, _316, _317, _318, _319,   \
+            _320, _321, _322, _323, _324, _325, _326, _327, _328, _329, _330, _331, _332, _333, _334, _335, _336,   \
+            _337, _338, _339, _340, _341, _342, _343, _344, _345, _346, _347, _348, _349, _350, _351, _352, _353,   \
+            _354, _355, _356, _357, _358, _359, _360, _361, _362, _363, _364, _365, _366, _367, _368, _369, _370,   \
+            _371, _372, _373, _374, _375, _376, _377, _378, _379, _380, _381, _382, _383, _384, _385, _386, _387,   \
+            _388, _389, _390, _391, _392, _393, _394, _395, _396, _397, _398, _399, _400, _401, _402, _403, _404,   \
+            _405, _406, _407, _408, _409, _410, _411, _412, _413, _414, _415, _416, _417, _418, _419, _420, _421,   \
+            _422, _423, _424, _425, _426, _427, _428, _429, _430, _431, _432, _433, _434, _435, _436, _437, _438,   \
+            _439, _440, _441, _442, _443, _444, _445, _446, _447, _448, _449, _450, _451, _452, _453, _454, _455,   \
+            _456, _457, _458, _459, _460, _461, _462, _463, _464, _465, _466, _467, _468, _469, _470, _471, _472,   \
+            _473, _474, _475, _476, _477, _478, _479, _480, _481, _482, _483, _484, _485, _486, _487, _488, _489,   \
+            _490, _491, _492, _493, _494, _495, _496, _497, _498, _499, _500, _501, _502, _503, _504, _505, _506,   \
+            _507, _508, _509, _510, _511, _512)                                                                     \
+    STRONG_FLAGS_APPLY_256(m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, \
+            _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39,     \
+            _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59,     \
+            _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78, _79,     \
+            _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99,     \
+            _100, _101, _102, _103, _104, _105, _106, _107, _108, _109, _110, _111, _112, _113, _114, _115, _116,   \
+            _117, _118, _119, _120, _121, _122, _123, _124, _125, _126, _127, _128, _129, _130, _131, _132, _133,   \
+            _134, _135, _136, _137, _138, _139, _140, _141, _142, _143, _144, _145, _146, _147, _148, _149, _150,   \
+            _151, _152, _153, _154, _155, _156, _157, _158, _159, _160, _161, _162, _163, _164, _165, _166, _167,   \
+            _168, _169, _170, _171, _172, _173, _174, _175, _176, _177, _178, _179, _180, _181, _182, _183, _184,   \
+            _185, _186, _187, _188, _189, _190, _191, _192, _193, _194, _195, _196, _197, _198, _199, _200, _201,   \
+            _202, _203, _204, _205, _206, _207, _208, _209, _210, _211, _212, _213, _214, _215, _216, _217, _218,   \
+            _219, _220, _221, _222, _223, _224, _225, _226, _227, _228, _229, _230, _231, _232, _233, _234, _235,   \
+            _236, _237, _238, _239, _240, _241, _242, _243, _244, _245, _246, _247, _248, _249, _250, _251, _252,   \
+            _253, _254, _255, _256)                                                                                 \
+    STRONG_FLAGS_APPLY_256(m, _257, _258, _259, _260, _261, _262, _263, _264, _265, _266, _267, _268, _269, _270,   \
+            _271, _272, _273, _274, _275, _276, _277, _278, _279, _280, _281, _282, _283, _284, _285, _286, _287,   \
+            _288, _289, _290, _291, _292, _293, _294, _295, _296, _297, _298, _299, _300, _301, _302, _303, _304,   \
+            _305, _306, _307, _308, _309, _310, _311, _312, _313, _314, _315, _316, _317, _318, _319, _320, _321,   \
+            _322, _323, _324, _325, _326, _327, _328, _329, _330, _331, _332, _333, _334, _335, _336, _337, _338,   \
+            _339, _340, _341, _342, _343, _344, _345, _346, _347, _348, _349, _350, _351, _352, _353, _354, _355,   \
+            _356, _357, _358, _359, _360, _361, _362, _363, _364, _365, _366, _367, _368, _369, _370, _371, _372,   \
+            _373, _374, _375, _376, _377, _378, _379, _380, _381, _382, _383, _384, _385, _386, _387, _388, _389,   \
+            _390, _391, _392, _393, _394, _395, _396, _397, _398, _399, _400, _401, _402, _403, _404, _405, _406,   \
+            _407, _408, _409, _410, _411, _412, _413, _414, _415, _416, _417, _418, _419, _420, _421, _422, _423,   \
+            _424, _425, _426, _427, _428, _429, _430, _431, _432, _433, _434, _435, _436, _437, _438, _439, _440,   \
+            _441, _442, _443, _444, _445, _446, _447, _448, _449, _450, _451, _452, _453, _454, _455, _456, _457,   \
+            _458, _459, _460, _461, _462, _463, _464, _465, _466, _467, _468, _469, _470, _471, _472, _473, _474,   \
+            _475, _476, _477, _478, _479, _480, _481, _482, _483, _484, _485, _486, _487, _488, _489, _490, _491,   \
+            _492, _493, _494, _495, _496, _497, _498, _499, _500, _501, _502, _503, _504, _505, _506, _507, _508,   \
+            _509, _510, _511, _512)
+
+#define STRONG_FLAGS_END_16 STRONG_FLAGS_END, STRONG_FLAGS_END, STRONG_FLAGS_END, STRONG_FLAGS_END,                 \
+            STRONG_FLAGS_END, STRONG_FLAGS_END, STRONG_FLAGS_END, STRONG_FLAGS_END, STRONG_FLAGS_END,               \
+            STRONG_FLAGS_END, STRONG_FLAGS_END, STRONG_FLAGS_END, STRONG_FLAGS_END, STRONG_FLAGS_END,               \
+            STRONG_FLAGS_END, STRONG_FLAGS_END
+#define STRONG_FLAGS_END_32 STRONG_FLAGS_END_16, STRONG_FLAGS_END_16
+#define STRONG_FLAGS_END_64 STRONG_FLAGS_END_32, STRONG_FLAGS_END_32
+#define STRONG_FLAGS_END_128 STRONG_FLAGS_END_64, STRONG_FLAGS_END_64
+#define STRONG_FLAGS_END_256 STRONG_FLAGS_END_128, STRONG_FLAGS_END_128
+
+// Continues with `level` unless the first remaining name is a marker. Levels are entered through
+// STRONG_FLAGS_ENTER_<level>, whose argument expansion splits the STRONG_FLAGS_END_<n> padding into
+// separate markers.
+#define STRONG_FLAGS_DISCARD(...)
+#define STRONG_FLAGS_NEXT_0(level) STRONG_FLAGS_PASTE(STRONG_FLAGS_ENTER_, level)
+#define STRONG_FLAGS_NEXT_1(level) STRONG_FLAGS_DISCARD
+#define STRONG_FLAGS_NEXT(level, next) STRONG_FLAGS_PASTE(STRONG_FLAGS_NEXT_, STRONG_FLAGS_IS_END(next))(level)
+#define STRONG_FLAGS_ENTER_2(...) STRONG_FLAGS_FOR_EACH_2(__VA_ARGS__)
+#define STRONG_FLAGS_ENTER_3(...) STRONG_FLAGS_FOR_EACH_3(__VA_ARGS__)
+#define STRONG_FLAGS_ENTER_4(...) STRONG_FLAGS_FOR_EACH_4(__VA_ARGS__)
+#define STRONG_FLAGS_ENTER_5(...) STRONG_FLAGS_FOR_EACH_5(__VA_ARGS__)
+#define STRONG_FLAGS_ENTER_6(...) STRONG_FLAGS_FOR_EACH_6(__VA_ARGS__)
+#define STRONG_FLAGS_ENTER_7(...) STRONG_FLAGS_FOR_EACH_7(__VA_ARGS__)
+#define STRONG_FLAGS_ENTER_8(...) STRONG_FLAGS_FOR_EACH_8(__VA_ARGS__)
+
+#define STRONG_FLAGS_FOR_EACH_1(m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16,           \
+            next, ...)                                                                                              \
+    STRONG_FLAGS_APPLY_16(m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16)                 \
+    STRONG_FLAGS_NEXT(2, next)(m, next, __VA_ARGS__)
+#define STRONG_FLAGS_FOR_EACH_2(m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16,           \
+            next, ...)                                                                                              \
+    STRONG_FLAGS_APPLY_16(m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16)                 \
+    STRONG_FLAGS_NEXT(3, next)(m, next, __VA_ARGS__, STRONG_FLAGS_END_16)
+#define STRONG_FLAGS_FOR_EACH_3(m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, \
+            _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, next, ...)                        \
+    STRONG_FLAGS_APPLY_32(m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19,  \
+            _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32)                                        \
+    STRONG_FLAGS_NEXT(4, next)(m, next, __VA_ARGS__, STRONG_FLAGS_END_32)
+#define STRONG_FLAGS_FOR_EACH_4(m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, \
+            _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38,     \
+            _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58,     \
+            _59, _60, _61, _62, _63, _64, next, ...)                                                                \
+    STRONG_FLAGS_APPLY_64(m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19,  \
+            _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39,     \
+            _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59,     \
+            _60, _61, _62, _63, _64)                                                                                \
+    STRONG_FLAGS_NEXT(5, next)(m, next, __VA_ARGS__, STRONG_FLAGS_END_64)
+#define STRONG_FLAGS_FOR_EACH_5(m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, \
+            _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38,     \
+            _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58,     \
+            _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78,     \
+            _79, _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98,     \
+            _99, _100, _101, _102, _103, _104, _105, _106, _107, _108, _109, _110, _111, _112, _113, _114, _115,    \
+            _116, _117, _118, _119, _120, _121, _122, _123, _124, _125, _126, _127, _128, next, ...)                \
+    STRONG_FLAGS_APPLY_128(m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, \
+            _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39,     \
+            _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59,     \
+            _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78, _79,     \
+            _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99,     \
+            _100, _101, _102, _103, _104, _105, _106, _107, _108, _109, _110, _111, _112, _113, _114, _115, _116,   \
+            _117, _118, _119, _120, _121, _122, _123, _124, _125, _126, _127, _128)                                 \
+    STRONG_FLAGS_NEXT(6, next)(m, next, __VA_ARGS__, STRONG_FLAGS_END_128)
+#define STRONG_FLAGS_FOR_EACH_6(m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, \
+            _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38,     \
+            _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58,     \
+            _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78,     \
+            _79, _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98,     \
+            _99, _100, _101, _102, _103, _104, _105, _106, _107, _108, _109, _110, _111, _112, _113, _114, _115,    \
+            _116, _117, _118, _119, _120, _121, _122, _123, _124, _125, _126, _127, _128, _129, _130, _131, _132,   \
+            _133, _134, _135, _136, _137, _138, _139, _140, _141, _142, _143, _144, _145, _146, _147, _148, _149,   \
+            _150, _151, _152, _153, _154, _155, _156, _157, _158, _159, _160, _161, _162, _163, _164, _165, _166,   \
+            _167, _168, _169, _170, _171, _172, _173, _174, _175, _176, _177, _178, _179, _180, _181, _182, _183,   \
+            _184, _185, _186, _187, _188, _189, _190, _191, _192, _193, _194, _195, _196, _197, _198, _199, _200,   \
+            _201, _202, _203, _204, _205, _206, _207, _208, _209, _210, _211, _212, _213, _214, _215, _216, _217,   \
+            _218, _219, _220, _221, _222, _223, _224, _225, _226, _227, _228, _229, _230, _231, _232, _233, _234,   \
+            _235, _236, _237, _238, _239, _240, _241, _242, _243, _244, _245, _246, _247, _248, _249, _250, _251,   \
+            _252, _253, _254, _255, _256, next, ...)                                                                \
+    STRONG_FLAGS_APPLY_256(m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, \
+            _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39,     \
+            _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59,     \
+            _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78, _79,     \
+            _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99,     \
+            _100, _101, _102, _103, _104, _105, _106, _107, _108, _109, _110, _111, _112, _113, _114, _115, _116,   \
+            _117, _118, _119, _120, _121, _122, _123, _124, _125, _126, _127, _128, _129, _130, _131, _132, _133,   \
+            _134, _135, _136, _137, _138, _139, _140, _141, _142, _143, _144, _145, _146, _147, _148, _149, _150,   \
+            _151, _152, _153, _154, _155, _156, _157, _158, _159, _160, _161, _162, _163, _164, _165, _166, _167,   \
+            _168, _169, _170, _171, _172, _173, _174, _175, _176, _177, _178, _179, _180, _181, _182, _183, _184,   \
+            _185, _186, _187, _188, _189, _190, _191, _192, _193, _194, _195, _196, _197, _198, _199, _200, _201,   \
+            _202, _203, _204, _205, _206, _207, _208, _209, _210, _211, _212, _213, _214, _215, _216, _217, _218,   \
+            _219, _220, _221, _222, _223, _224, _225, _226, _227, _228, _229, _230, _231, _232, _233, _234, _235,   \
+            _236, _237, _238, _239, _240, _241, _242, _243, _244, _245, _246, _247, _248, _249, _250, _251, _252,   \
+            _253, _254, _255, _256)                                                                                 \
+    STRONG_FLAGS_NEXT(7, next)(m, next, __VA_ARGS__, STRONG_FLAGS_END_256)
+#define STRONG_FLAGS_FOR_EACH_7(m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, \
+            _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38,     \
+            _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58,     \
+            _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78,     \
+            _79, _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98,     \
+            _99, _100, _101, _102, _103, _104, _105, _106, _107, _108, _109, _110, _111, _112, _113, _114, _115,    \
+            _116, _117, _118, _119, _120, _121, _122, _123, _124, _125, _126, _127, _128, _129, _130, _131, _132,   \
+            _133, _134, _135, _136, _137, _138, _139, _140, _141, _142, _143, _144, _145, _146, _147, _148, _149,   \
+            _150, _151, _152, _153, _154, _155, _156, _157, _158, _159, _160, _161, _162, _163, _164, _165, _166,   \
+            _167, _168, _169, _170, _171, _172, _173, _174, _175, _176, _177, _178, _179, _180, _181, _182, _183,   \
+            _184, _185, _186, _187, _188, _189, _190, _191, _192, _193, _194, _195, _196, _197, _198, _199, _200,   \
+            _201, _202, _203, _204, _205, _206, _207, _208, _209, _210, _211, _212, _213, _214, _215, _216, _217,   \
+            _218, _219, _220, _221, _222, _223, _224, _225, _226, _227, _228, _229, _230, _231, _232, _233, _234,   \
+            _235, _236, _237, _238, _239, _240, _241, _242, _243, _244, _245, _246, _247, _248, _249, _250, _251,   \
+            _252, _253, _254, _255, _256, _257, _258, _259, _260, _261, _262, _263, _264, _265, _266, _267, _268,   \
+            _269, _270, _271, _272, _273, _274, _275, _276, _277, _278, _279, _280, _281, _282, _283, _284, _285,   \
+            _286, _287, _288, _289, _290, _291, _292, _293, _294, _295, _296, _297, _298, _299, _300, _301, _302,   \
+            _303, _304, _305, _306, _307, _308, _309, _310, _311, _312, _313, _314, _315, _316, _317, _318, _319,   \
+            _320, _321, _322, _323, _324, _325, _326, _327, _328, _329, _330, _331, _332, _333, _334, _335, _336,   \
+            _337, _338, _339, _340, _341, _342, _343, _344, _345, _346, _347, _348, _349, _350, _351, _352, _353,   \
+            _354, _355, _356, _357, _358, _359, _360, _361, _362, _363, _364, _365, _366, _367, _368, _369, _370,   \
+            _371, _372, _373, _374, _375, _376, _377, _378, _379, _380, _381, _382, _383, _384, _385, _386, _387,   \
+            _388, _389, _390, _391, _392, _393, _394, _395, _396, _397, _398, _399, _400, _401, _402, _403, _404,   \
+            _405, _406, _407, _408, _409, _410, _411, _412, _413, _414, _415, _416, _417, _418, _419, _420, _421,   \
+            _422, _423, _424, _425, _426, _427, _428, _429, _430, _431, _432, _433, _434, _435, _436, _437, _438,   \
+            _439, _440, _441, _442, _443, _444, _445, _446, _447, _448, _449, _450, _451, _452, _453, _454, _455,   \
+            _456, _457, _458, _459, _460, _461, _462, _463, _464, _465, _466, _467, _468, _469, _470, _471, _472,   \
+            _473, _474, _475, _476, _477, _478, _479, _480, _481, _482, _483, _484, _485, _486, _487, _488, _489,   \
+            _490, _491, _492, _493, _494, _495, _496, _497, _498, _499, _500, _501, _502, _503, _504, _505, _506,   \
+            _507, _508, _509, _510, _511, _512, next, ...)                                                          \
+    STRONG_FLAGS_APPLY_512(m, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, \
+            _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39,     \
+            _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59,     \
+            _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78, _79,     \
+            _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99,     \
+            _100, _101, _102, _103, _104, _105, _106, _107, _108, _109, _110, _111, _112, _113, _114, _115, _116,   \
+            _117, _118, _119, _120, _121, _122, _123, _124, _125, _126, _127, _128, _129, _130, _131, _132, _133,   \
+            _134, _135, _136, _137, _138, _139, _140, _141, _142, _143, _144, _145, _146, _147, _148, _149, _150,   \
+            _151, _152, _153, _154, _155, _156, _157, _158, _159, _160, _161, _162, _163, _164, _165, _166, _167,   \
+            _168, _169, _170, _171, _172, _173, _174, _175, _176, _177, _178, _179, _180, _181, _182, _183, _184,   \
+            _185, _186, _187, _188, _189, _190, _191, _192, _193, _194, _195, _196, _197, _198, _199, _200, _201,   \
+            _202, _203, _204, _205, _206, _207, _208, _209, _210, _211, _212, _213, _214, _215, _216, _217, _218,   \
+            _219, _220, _221, _222, _223, _224, _225, _226, _227, _228, _229, _230, _231, _232, _233, _234, _235,   \
+            _236, _237, _238, _239, _240, _241, _242, _243, _244, _245, _246, _247, _248, _249, _250, _251, _252,   \
+            _253, _254, _255, _256, _257, _258, _259, _260, _261, _262, _263, _264, _265, _266, _267, _268, _269,   \
+            _270, _271, _272, _273, _274, _275, _276, _277, _278, _279, _280, _281, _282, _283, _284, _285, _286,   \
+            _287, _288, _289, _290, _291, _292, _293, _294, _295, _296, _297, _298, _299, _300, _301, _302, _303,   \
+            _304, _305, _306, _307, _308, _309, _310, _311, _312, _313, _314, _315, _316, _317, _318, _319, _320,   \
+            _321, _322, _323, _324, _325, _326, _327, _328, _329, _330, _331, _332, _333, _334, _335, _336, _337,   \
+            _338, _339, _340, _341, _342, _343, _344, _345, _346, _347, _348, _349, _350, _351, _352, _353, _354,   \
+            _355, _356, _357, _358, _359, _360, _361, _362, _363, _364, _365, _366, _367, _368, _369, _370, _371,   \
+            _372, _373, _374, _375, _376, _377, _378, _379, _380, _381, _382, _383, _384, _385, _386, _387, _388,   \
+            _389, _390, _391, _392, _393, _394, _395, _396, _397, _398, _399, _400, _401, _402, _403, _404, _405,   \
+            _406, _407, _408, _409, _410, _411, _412, _413, _414, _415, _416, _417, _418, _419, _420, _421, _422,   \
+            _423, _424, _425, _426, _427, _428, _429, _430, _431, _432, _433, _434, _435, _436, _437, _438, _439,   \
+            _440, _441, _442, _443, _444, _445, _446, _447, _448, _449, _450, _451, _452, _453, _454, _455, _456,   \
+            _457, _458, _459, _460, _461, _462, _463, _464, _465, _466, _467, _468, _469, _470, _471, _472, _473,   \
+            _474, _475, _476, _477, _478, _479, _480, _481, _482, _483, _484, _485, _486, _487, _488, _489, _490,   \
+            _491, _492, _493, _494, _495, _496, _497, _498, _499, _500, _501, _502, _503, _504, _505, _506, _507,   \
+            _508, _509, _510, _511, _512)                                                                           \
+    STRONG_FLAGS_NEXT(8, next)(m, next, __VA_ARGS__)
+#define STRONG_FLAGS_FOR_EACH_8(...) static_assert(false, "Flag lists are limited to 1024 names");
+
+#define STRONG_FLAGS_FOR_EACH(macro, ...)                                                                   \
+    STRONG_FLAGS_FOR_EACH_1(macro, __VA_ARGS__, STRONG_FLAGS_END, STRONG_FLAGS_END, STRONG_FLAGS_END,       \
+            STRONG_FLAGS_END, STRONG_FLAGS_END, STRONG_FLAGS_END, STRONG_FLAGS_END, STRONG_FLAGS_END,       \
+            STRONG_FLAGS_END, STRONG_FLAGS_END, STRONG_FLAGS_END, STRONG_FLAGS_END, STRONG_FLAGS_END,       \
+            STRONG_FLAGS_END, STRONG_FLAGS_END, STRONG_FLAGS_END, STRONG_FLAGS_END)
+
 #define STRONG_FLAGS_MAKE_FLAG_BIT(name, bit) static constexpr type::bit_type STRONG_FLAGS_PASTE(name, _bit) = (bit)
 #define STRONG_FLAGS_MAKE_FLAG_VALUE(name, bit) static constexpr type name = type::from_bit(bit)
 
-#define STRONG_FLAGS_MAKE_FLAG(name, bit)       \
+#define STRONG_FLAGS_MAKE_NAMED_FLAG(name)                                                                  \
+    STRONG_FLAGS_MAKE_FLAG_BIT(name, strong_flags_bits::name);                                              \
+    STRONG_FLAGS_MAKE_FLAG_VALUE(name, strong_flags_bits::name);
+
+// The constants of one flag: STRONG_FLAGS_MAKE_FLAG(name) takes the bit from the strong_flags_bits enum,
+// STRONG_FLAGS_MAKE_FLAG(name, bit) places it explicitly and, as before, leaves the final semicolon to
+// the caller.
+#define STRONG_FLAGS_MAKE_FLAG_AT(name, bit)    \
     STRONG_FLAGS_MAKE_FLAG_BIT(name, bit);      \
     STRONG_FLAGS_MAKE_FLAG_VALUE(name, bit)
+#define STRONG_FLAGS_MAKE_FLAG_SELECT(_1, _2, macro, ...) macro
+#define STRONG_FLAGS_MAKE_FLAG(...)                                                                         \
+    STRONG_FLAGS_MAKE_FLAG_SELECT(__VA_ARGS__, STRONG_FLAGS_MAKE_FLAG_AT, STRONG_FLAGS_MAKE_NAMED_FLAG, ~)       \
+            (__VA_ARGS__)
 
-#define STRONG_FLAGS_MAKE_FLAGS_1(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 1)
-#define STRONG_FLAGS_MAKE_FLAGS_2(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 2);                        \
-    STRONG_FLAGS_MAKE_FLAGS_1(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_3(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 3);                        \
-    STRONG_FLAGS_MAKE_FLAGS_2(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_4(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 4);                        \
-    STRONG_FLAGS_MAKE_FLAGS_3(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_5(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 5);                        \
-    STRONG_FLAGS_MAKE_FLAGS_4(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_6(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 6);                        \
-    STRONG_FLAGS_MAKE_FLAGS_5(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_7(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 7);                        \
-    STRONG_FLAGS_MAKE_FLAGS_6(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_8(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 8);                        \
-    STRONG_FLAGS_MAKE_FLAGS_7(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_9(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 9);                        \
-    STRONG_FLAGS_MAKE_FLAGS_8(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_10(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 10);                      \
-    STRONG_FLAGS_MAKE_FLAGS_9(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_11(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 11);                      \
-    STRONG_FLAGS_MAKE_FLAGS_10(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_12(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 12);                      \
-    STRONG_FLAGS_MAKE_FLAGS_11(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_13(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 13);                      \
-    STRONG_FLAGS_MAKE_FLAGS_12(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_14(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 14);                      \
-    STRONG_FLAGS_MAKE_FLAGS_13(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_15(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 15);                      \
-    STRONG_FLAGS_MAKE_FLAGS_14(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_16(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 16);                      \
-    STRONG_FLAGS_MAKE_FLAGS_15(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_17(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 17);                      \
-    STRONG_FLAGS_MAKE_FLAGS_16(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_18(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 18);                      \
-    STRONG_FLAGS_MAKE_FLAGS_17(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_19(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 19);                      \
-    STRONG_FLAGS_MAKE_FLAGS_18(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_20(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 20);                      \
-    STRONG_FLAGS_MAKE_FLAGS_19(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_21(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 21);                      \
-    STRONG_FLAGS_MAKE_FLAGS_20(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_22(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 22);                      \
-    STRONG_FLAGS_MAKE_FLAGS_21(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_23(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 23);                      \
-    STRONG_FLAGS_MAKE_FLAGS_22(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_24(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 24);                      \
-    STRONG_FLAGS_MAKE_FLAGS_23(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_25(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 25);                      \
-    STRONG_FLAGS_MAKE_FLAGS_24(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_26(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 26);                      \
-    STRONG_FLAGS_MAKE_FLAGS_25(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_27(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 27);                      \
-    STRONG_FLAGS_MAKE_FLAGS_26(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_28(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 28);                      \
-    STRONG_FLAGS_MAKE_FLAGS_27(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_29(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 29);                      \
-    STRONG_FLAGS_MAKE_FLAGS_28(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_30(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 30);                      \
-    STRONG_FLAGS_MAKE_FLAGS_29(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_31(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 31);                      \
-    STRONG_FLAGS_MAKE_FLAGS_30(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_32(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 32);                      \
-    STRONG_FLAGS_MAKE_FLAGS_31(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_33(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 33);                      \
-    STRONG_FLAGS_MAKE_FLAGS_32(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_34(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 34);                      \
-    STRONG_FLAGS_MAKE_FLAGS_33(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_35(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 35);                      \
-    STRONG_FLAGS_MAKE_FLAGS_34(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_36(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 36);                      \
-    STRONG_FLAGS_MAKE_FLAGS_35(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_37(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 37);                      \
-    STRONG_FLAGS_MAKE_FLAGS_36(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_38(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 38);                      \
-    STRONG_FLAGS_MAKE_FLAGS_37(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_39(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 39);                      \
-    STRONG_FLAGS_MAKE_FLAGS_38(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_40(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 40);                      \
-    STRONG_FLAGS_MAKE_FLAGS_39(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_41(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 41);                      \
-    STRONG_FLAGS_MAKE_FLAGS_40(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_42(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 42);                      \
-    STRONG_FLAGS_MAKE_FLAGS_41(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_43(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 43);                      \
-    STRONG_FLAGS_MAKE_FLAGS_42(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_44(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 44);                      \
-    STRONG_FLAGS_MAKE_FLAGS_43(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_45(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 45);                      \
-    STRONG_FLAGS_MAKE_FLAGS_44(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_46(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 46);                      \
-    STRONG_FLAGS_MAKE_FLAGS_45(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_47(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 47);                      \
-    STRONG_FLAGS_MAKE_FLAGS_46(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_48(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 48);                      \
-    STRONG_FLAGS_MAKE_FLAGS_47(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_49(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 49);                      \
-    STRONG_FLAGS_MAKE_FLAGS_48(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_50(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 50);                      \
-    STRONG_FLAGS_MAKE_FLAGS_49(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_51(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 51);                      \
-    STRONG_FLAGS_MAKE_FLAGS_50(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_52(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 52);                      \
-    STRONG_FLAGS_MAKE_FLAGS_51(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_53(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 53);                      \
-    STRONG_FLAGS_MAKE_FLAGS_52(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_54(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 54);                      \
-    STRONG_FLAGS_MAKE_FLAGS_53(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_55(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 55);                      \
-    STRONG_FLAGS_MAKE_FLAGS_54(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_56(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 56);                      \
-    STRONG_FLAGS_MAKE_FLAGS_55(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_57(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 57);                      \
-    STRONG_FLAGS_MAKE_FLAGS_56(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_58(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 58);                      \
-    STRONG_FLAGS_MAKE_FLAGS_57(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_59(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 59);                      \
-    STRONG_FLAGS_MAKE_FLAGS_58(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_60(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 60);                      \
-    STRONG_FLAGS_MAKE_FLAGS_59(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_61(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 61);                      \
-    STRONG_FLAGS_MAKE_FLAGS_60(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_62(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 62);                      \
-    STRONG_FLAGS_MAKE_FLAGS_61(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_63(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 63);                      \
-    STRONG_FLAGS_MAKE_FLAGS_62(count, __VA_ARGS__)
-#define STRONG_FLAGS_MAKE_FLAGS_64(count, flag, ...) STRONG_FLAGS_MAKE_FLAG(flag, count - 64);                      \
-    STRONG_FLAGS_MAKE_FLAGS_63(count, __VA_ARGS__)
-
-#define STRONG_FLAGS_MAKE_FLAGS(count, ...) \
-    STRONG_FLAGS_PASTE(STRONG_FLAGS_MAKE_FLAGS_, count)(count, __VA_ARGS__)
-
-
-
-#define STRONG_FLAGS_DEFINE_CLASS(underlying_type, bitsize)                                                 \
-    class type : public ::strong_flags::impl<type, underlying_type, bitsize> {                              \
+#define STRONG_FLAGS_DEFINE_CLASS(underlying_type, bitsize, name_list, type_name_string)                   \
+    class type : public ::strong_flags::impl<type,                                                          \
+            ::strong_flags::storage_t<underlying_type, bitsize>, bitsize> {                                 \
     private:                                                                                                \
-        using base_type = ::strong_flags::impl<type, underlying_type, bitsize>;                             \
+        using base_type = ::strong_flags::impl<type,                                                        \
+                ::strong_flags::storage_t<underlying_type, bitsize>, bitsize>;                              \
                                                                                                             \
     public:                                                                                                 \
         using base_type::base_type;                                                                         \
+                                                                                                            \
+        static constexpr ::strong_flags::name_table<bitsize> names { name_list };                           \
+        static constexpr std::string_view type_name { type_name_string };                                   \
     }
 
 #define STRONG_FLAGS_DEFINE_FACTORY_FUNCTIONS                                                               \
@@ -361,12 +1395,42 @@ private:
 
 #define STRONG_FLAGS_DEFINE_FLAGS(name, underlying_type, ...)                                               \
 namespace name{                                                                                             \
-    STRONG_FLAGS_DEFINE_CLASS(underlying_type, STRONG_FLAGS_ARG_COUNT(__VA_ARGS__));                        \
+    struct strong_flags_bits {                                                                              \
+        enum : std::size_t { __VA_ARGS__, strong_flags_count };                                             \
+    };                                                                                                      \
+                                                                                                            \
+    STRONG_FLAGS_DEFINE_CLASS(underlying_type, strong_flags_bits::strong_flags_count, #__VA_ARGS__, #name); \
                                                                                                             \
-    STRONG_FLAGS_MAKE_FLAGS(STRONG_FLAGS_ARG_COUNT(__VA_ARGS__), __VA_ARGS__);                              \
+    STRONG_FLAGS_FOR_EACH(STRONG_FLAGS_MAKE_NAMED_FLAG, __VA_ARGS__)                                        \
                                                                                                             \
     STRONG_FLAGS_DEFINE_FACTORY_FUNCTIONS                                                                   \
 }
 
+#define STRONG_FLAGS_DEFINE_MINIMAL_FLAGS(name, ...)                                                        \
+    STRONG_FLAGS_DEFINE_FLAGS(name, ::strong_flags::minimal, __VA_ARGS__)
+
+// The helpers STRONG_FLAGS_DEFINE_FLAGS was built from before the flag list walk, for code that assembles
+// flag types by hand. STRONG_FLAGS_ARG_COUNT still stops at 64 arguments. STRONG_FLAGS_MAKE_FLAGS numbers
+// the names from 0 and declares a strong_flags_bits enum, so it can be used once per namespace.
+#define STRONG_FLAGS_ARG_COUNT_IMPL(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17,     \
+    _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39,   \
+    _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61,   \
+    _62, _63, _64, count, ...) count
+
+#define STRONG_FLAGS_ARG_COUNT(...)                                                                                 \
+    STRONG_FLAGS_ARG_COUNT_IMPL(__VA_ARGS__, 64, 63, 62, 61, 60, 59, 58, 57, 56, 55, 54, 53, 52, 51, 50, 49, 48,    \
+            47, 46, 45, 44, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, \
+            21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1)
+
+#define STRONG_FLAGS_MAKE_FLAGS(count, ...)                                                                 \
+    struct strong_flags_bits {                                                                              \
+        enum : std::size_t { __VA_ARGS__, strong_flags_count };                                             \
+    };                                                                                                      \
+    static_assert(strong_flags_bits::strong_flags_count == (count), "Flag count does not match the names"); \
+    STRONG_FLAGS_FOR_EACH(STRONG_FLAGS_MAKE_NAMED_FLAG, __VA_ARGS__)
+
+#if defined(STRONG_FLAGS_TRACE_ALL)
+#include "trace.hpp"
+#endif
 
 #endif /* INCLUDE_STRONG_FLAGS_H_ */
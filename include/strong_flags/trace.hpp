@@ -0,0 +1,323 @@
+#ifndef INCLUDE_STRONG_FLAGS_TRACE_H_
+#define INCLUDE_STRONG_FLAGS_TRACE_H_
+
+#include "strong_flags.hpp"
+#include "format.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#pragma intrinsic(_ReturnAddress)
+#define STRONG_FLAGS_TRACE_NOINLINE __declspec(noinline)
+#define STRONG_FLAGS_TRACE_CALLER _ReturnAddress()
+#else
+#define STRONG_FLAGS_TRACE_NOINLINE __attribute__((noinline))
+#define STRONG_FLAGS_TRACE_CALLER __builtin_return_address(0)
+#endif
+
+// Records kept per thread; the oldest are overwritten first.
+#if !defined(STRONG_FLAGS_TRACE_CAPACITY)
+#define STRONG_FLAGS_TRACE_CAPACITY 1024
+#endif
+
+// Traces the mutations of `type`: set, clear, toggle and the compound assignments. Use at global scope,
+// before any of these members is called on `type`.
+#define STRONG_FLAGS_TRACE_FLAGS(type)                                                                      \
+    template<> struct strong_flags::traced<type> : std::true_type {                                         \
+        static constexpr const char* name = #type;                                                          \
+    }
+
+namespace strong_flags {
+
+namespace detail {
+
+constexpr std::size_t trace_capacity = STRONG_FLAGS_TRACE_CAPACITY;
+
+static_assert(trace_capacity != 0 && (trace_capacity & (trace_capacity - 1)) == 0,
+        "STRONG_FLAGS_TRACE_CAPACITY must be a power of two");
+
+struct trace_type {
+    const char* name;
+    std::size_t (*format)(char* buffer, std::size_t capacity, std::uint64_t value) noexcept;
+};
+
+template<typename FlagType, typename = void>
+struct trace_has_name : std::false_type {
+};
+
+template<typename FlagType>
+struct trace_has_name<FlagType, std::void_t<decltype(traced<FlagType>::name)>> : std::true_type {
+};
+
+template<typename FlagType, typename = void>
+struct trace_has_names : std::false_type {
+};
+
+template<typename FlagType>
+struct trace_has_names<FlagType, std::void_t<decltype(FlagType::names)>> : std::true_type {
+};
+
+template<typename FlagType>
+struct trace_descriptor {
+    static std::size_t format(char* buffer, std::size_t capacity, std::uint64_t value) noexcept {
+        using underlying_type = typename FlagType::underlying_type;
+        if constexpr (trace_has_names<FlagType>::value) {
+            const auto flags = FlagType::from_underlying_type(static_cast<underlying_type>(value));
+            return format_to(buffer, capacity, flags);
+        } else {
+            const int length = std::snprintf(buffer, capacity, "0x%" PRIx64, value);
+            return length < 0 ? 0 : static_cast<std::size_t>(length);
+        }
+    }
+
+    static const char* name() noexcept {
+        if constexpr (trace_has_name<FlagType>::value) {
+            return traced<FlagType>::name;
+        } else {
+            return typeid(FlagType).name();
+        }
+    }
+
+    static inline const trace_type s_type { name(), &format };
+};
+
+// Every field is an atomic so that readers may copy a slot while its thread overwrites it; the copy is
+// then discarded, see trace_buffer::collect.
+struct trace_slot {
+    std::atomic<std::uint64_t> timestamp { 0 };
+    std::atomic<std::uint64_t> thread { 0 };
+    std::atomic<std::uint64_t> old_value { 0 };
+    std::atomic<std::uint64_t> new_value { 0 };
+    std::atomic<const void*> site { nullptr };
+    std::atomic<const trace_type*> type { nullptr };
+};
+
+}
+
+namespace trace {
+
+struct record {
+    std::uint64_t timestamp;  // steady_clock, nanoseconds
+    std::uint64_t thread;     // std::hash of the writing std::thread::id
+    std::uint64_t old_value;
+    std::uint64_t new_value;
+    const void* site;         // address in the code that called the mutator
+    const detail::trace_type* type;
+
+    template<typename FlagType>
+    bool is() const noexcept {
+        return type == &detail::trace_descriptor<FlagType>::s_type;
+    }
+
+    template<typename FlagType>
+    FlagType old_flags() const noexcept {
+        return FlagType::from_underlying_type(static_cast<typename FlagType::underlying_type>(old_value));
+    }
+
+    template<typename FlagType>
+    FlagType new_flags() const noexcept {
+        return FlagType::from_underlying_type(static_cast<typename FlagType::underlying_type>(new_value));
+    }
+};
+
+}
+
+namespace detail {
+
+// Ring of the most recent records of one thread. The owning thread is the only writer: it announces the
+// index it is about to overwrite in m_claimed, fills the slot with relaxed stores and publishes it through
+// m_head. A reader that copied a slot checks m_claimed afterwards to learn whether the copy may be torn.
+class trace_buffer {
+public:
+    void push(const trace_type* type, std::uint64_t old_value, std::uint64_t new_value,
+            const void* site, std::uint64_t thread) noexcept {
+        const auto head = m_head.load(std::memory_order_relaxed);
+        m_claimed.store(head + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        auto& slot = m_slots[head & (trace_capacity - 1)];
+        const auto now = std::chrono::steady_clock::now().time_since_epoch();
+        slot.timestamp.store(static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()), std::memory_order_relaxed);
+        slot.thread.store(thread, std::memory_order_relaxed);
+        slot.old_value.store(old_value, std::memory_order_relaxed);
+        slot.new_value.store(new_value, std::memory_order_relaxed);
+        slot.site.store(site, std::memory_order_relaxed);
+        slot.type.store(type, std::memory_order_relaxed);
+        m_head.store(head + 1, std::memory_order_release);
+    }
+
+    void collect(std::vector<trace::record>& out) const {
+        const auto head = m_head.load(std::memory_order_acquire);
+        const auto first = head > trace_capacity ? head - trace_capacity : 0;
+        const auto start = out.size();
+        for (auto i = first; i < head; ++i) {
+            const auto& slot = m_slots[i & (trace_capacity - 1)];
+            out.push_back({ slot.timestamp.load(std::memory_order_relaxed),
+                    slot.thread.load(std::memory_order_relaxed),
+                    slot.old_value.load(std::memory_order_relaxed),
+                    slot.new_value.load(std::memory_order_relaxed),
+                    slot.site.load(std::memory_order_relaxed),
+                    slot.type.load(std::memory_order_relaxed) });
+        }
+
+        // Index i shares its slot with i + capacity; drop every copy the writer may have started to
+        // overwrite meanwhile.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const auto claimed = m_claimed.load(std::memory_order_relaxed);
+        const auto valid = claimed > trace_capacity ? claimed - trace_capacity : 0;
+        if (valid > first) {
+            const auto torn = std::min<std::uint64_t>(valid - first, head - first);
+            out.erase(out.begin() + static_cast<std::ptrdiff_t>(start),
+                    out.begin() + static_cast<std::ptrdiff_t>(start + torn));
+        }
+    }
+
+private:
+    std::atomic<std::uint64_t> m_head { 0 };
+    std::atomic<std::uint64_t> m_claimed { 0 };
+    trace_slot m_slots[trace_capacity];
+
+    friend class trace_registry;
+    bool m_in_use = false;
+};
+
+// Owns the buffers of all threads. A buffer outlives its thread and is handed to the next thread that
+// starts tracing, so the records of exited threads stay visible until they are overwritten.
+class trace_registry {
+public:
+    static trace_registry& instance() {
+        // Leaked so that threads still tracing during static destruction find it alive.
+        static trace_registry* const s_instance = new trace_registry;
+        return *s_instance;
+    }
+
+    trace_buffer* acquire() {
+        std::lock_guard<std::mutex> lock { m_mutex };
+        for (auto& buffer : m_buffers) {
+            if (!buffer->m_in_use) {
+                buffer->m_in_use = true;
+                return buffer.get();
+            }
+        }
+        m_buffers.emplace_back(new trace_buffer);
+        m_buffers.back()->m_in_use = true;
+        return m_buffers.back().get();
+    }
+
+    void release(trace_buffer* buffer) {
+        std::lock_guard<std::mutex> lock { m_mutex };
+        buffer->m_in_use = false;
+    }
+
+    std::vector<trace::record> snapshot() const {
+        std::vector<trace::record> res;
+        {
+            std::lock_guard<std::mutex> lock { m_mutex };
+            for (const auto& buffer : m_buffers) {
+                buffer->collect(res);
+            }
+        }
+        std::stable_sort(res.begin(), res.end(), [](const trace::record& lhs, const trace::record& rhs) {
+            return lhs.timestamp < rhs.timestamp;
+        });
+        return res;
+    }
+
+private:
+    mutable std::mutex m_mutex;
+    std::vector<std::unique_ptr<trace_buffer>> m_buffers;
+};
+
+struct trace_thread {
+    trace_buffer* buffer = trace_registry::instance().acquire();
+    std::uint64_t id = std::hash<std::thread::id> { }(std::this_thread::get_id());
+
+    ~trace_thread() {
+        trace_registry::instance().release(buffer);
+    }
+};
+
+inline trace_thread& local_trace_thread() {
+    thread_local trace_thread s_thread;
+    return s_thread;
+}
+
+// Out of line so that traced mutators only grow by a call. The mutators are force-inlined, so the return
+// address lies in their caller.
+template<typename FlagType, typename Underlying>
+STRONG_FLAGS_TRACE_NOINLINE void trace_record(Underlying old_value, Underlying new_value) noexcept {
+    static_assert(std::is_integral<Underlying>::value, "Only flag types with an integer underlying type are traced");
+    auto& thread = local_trace_thread();
+    using unsigned_type = typename std::make_unsigned<Underlying>::type;
+    thread.buffer->push(&trace_descriptor<FlagType>::s_type, static_cast<unsigned_type>(old_value),
+            static_cast<unsigned_type>(new_value), STRONG_FLAGS_TRACE_CALLER, thread.id);
+}
+
+}
+
+namespace trace {
+
+// The retained records of all threads, oldest first. Records written while the snapshot is taken may or
+// may not be part of it.
+inline std::vector<record> snapshot() {
+    return detail::trace_registry::instance().snapshot();
+}
+
+// Writes one line, without newline, with snprintf semantics:
+// <seconds>.<nanoseconds> <thread> <site> <type>: <old flags> -> <new flags>
+inline std::size_t format_record(char* buffer, std::size_t capacity, const record& rec) noexcept {
+    std::size_t length = 0;
+    const auto advance = [&](std::size_t written) {
+        length += written;
+        return length < capacity ? buffer + length : nullptr;
+    };
+    const auto print = [&](auto... args) {
+        const int written = std::snprintf(length < capacity ? buffer + length : nullptr,
+                length < capacity ? capacity - length : 0, args...);
+        advance(written < 0 ? 0 : static_cast<std::size_t>(written));
+    };
+    const auto flags = [&](std::uint64_t value) {
+        char* out = length < capacity ? buffer + length : nullptr;
+        advance(rec.type->format(out, out != nullptr ? capacity - length : 0, value));
+    };
+
+    print("%" PRIu64 ".%09" PRIu64 " %016" PRIx64 " %p %s: ", rec.timestamp / 1000000000,
+            rec.timestamp % 1000000000, rec.thread, rec.site, rec.type->name);
+    flags(rec.old_value);
+    print(" -> ");
+    flags(rec.new_value);
+    return length;
+}
+
+// Writes snapshot() to `out`, one record per line. Sites resolve with addr2line or a debugger.
+inline void dump(std::FILE* out = stderr) {
+    std::vector<char> line(256);
+    for (const auto& rec : snapshot()) {
+        const auto length = format_record(line.data(), line.size(), rec);
+        if (length >= line.size()) {
+            line.resize(length + 1);
+            format_record(line.data(), line.size(), rec);
+        }
+        std::fprintf(out, "%s\n", line.data());
+    }
+}
+
+}
+
+}
+
+#endif /* INCLUDE_STRONG_FLAGS_TRACE_H_ */
@@ -0,0 +1,93 @@
+#include "catch2/catch.hpp"
+#include "strong_flags/atomic.hpp"
+#include <thread>
+#include <vector>
+
+STRONG_FLAGS_DEFINE_FLAGS(Status, unsigned char, Ready, Busy, Failed, Done);
+
+TEST_CASE("atomic_load_store", "[atomic]") {
+    strong_flags::atomic<Status::type> a;
+
+    REQUIRE(a.load() == Status::type());
+    REQUIRE(a.is_lock_free() == true);
+
+    a.store(Status::Ready | Status::Done, std::memory_order_release);
+    REQUIRE(a.load(std::memory_order_acquire) == (Status::Ready | Status::Done));
+    REQUIRE(a.test(Status::Done_bit) == true);
+    REQUIRE(a.test_any(Status::Busy | Status::Done) == true);
+    REQUIRE(a.test_all(Status::Busy | Status::Done) == false);
+
+    REQUIRE(a.exchange(Status::Failed) == (Status::Ready | Status::Done));
+    REQUIRE(static_cast<Status::type>(a) == Status::Failed);
+}
+
+TEST_CASE("atomic_fetch_ops", "[atomic]") {
+    strong_flags::atomic<Status::type> a { Status::Ready };
+
+    REQUIRE(a.fetch_set(Status::Busy_bit) == Status::Ready);
+    REQUIRE(a.fetch_set(Status::Done, std::memory_order_relaxed) == (Status::Ready | Status::Busy));
+    REQUIRE(a.fetch_clear(Status::Ready_bit) == (Status::Ready | Status::Busy | Status::Done));
+    REQUIRE(a.fetch_clear(Status::Busy | Status::Failed, std::memory_order_acq_rel) == (Status::Busy | Status::Done));
+    REQUIRE(a.fetch_toggle(Status::Failed_bit) == Status::Done);
+    REQUIRE(a.fetch_toggle(Status::Failed | Status::Done) == (Status::Failed | Status::Done));
+    REQUIRE(a.load() == Status::type());
+
+    a.fetch_set(7);
+    a.fetch_toggle(6);
+    REQUIRE(a.load().to_underlying_type() == 0U);
+}
+
+TEST_CASE("atomic_compare_exchange", "[atomic]") {
+    strong_flags::atomic<Status::type> a { Status::Ready };
+
+    auto expected = Status::Busy;
+    REQUIRE(a.compare_exchange_strong(expected, Status::Done) == false);
+    REQUIRE(expected == Status::Ready);
+    REQUIRE(a.compare_exchange_strong(expected, Status::Done, std::memory_order_acq_rel) == true);
+    REQUIRE(a.load() == Status::Done);
+
+    REQUIRE(a.set_if_none(Status::Busy) == true);
+    REQUIRE(a.set_if_none(Status::Busy | Status::Failed) == false);
+    REQUIRE(a.set_if_none(Status::Failed, Status::Ready) == true);
+    REQUIRE(a.set_if_none(Status::Done, Status::Failed) == false);
+    REQUIRE(a.load() == (Status::Ready | Status::Busy | Status::Done));
+}
+
+TEST_CASE("atomic_concurrent", "[atomic]") {
+    strong_flags::atomic<Status::type> a;
+    std::atomic<int> winners { 0 };
+    std::vector<std::thread> threads;
+
+    for (Status::type::bit_type bit = 0; bit < 4; ++bit) {
+        threads.emplace_back([&a, &winners, bit] {
+            for (int i = 0; i < 1000; ++i) {
+                a.fetch_toggle(bit, std::memory_order_relaxed);
+            }
+            a.fetch_set(bit, std::memory_order_release);
+            if (a.set_if_none(Status::Failed | Status::Done, Status::Failed)) {
+                winners.fetch_add(1);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    REQUIRE(a.load() == (Status::Ready | Status::Busy | Status::Failed | Status::Done));
+    REQUIRE(winners.load() <= 1);
+}
+
+#if defined(__cpp_lib_atomic_wait)
+TEST_CASE("atomic_wait_notify", "[atomic]") {
+    strong_flags::atomic<Status::type> a;
+
+    std::thread waker([&a] {
+        a.fetch_set(Status::Ready, std::memory_order_release);
+        a.notify_all();
+    });
+    a.wait(Status::type(), std::memory_order_acquire);
+    waker.join();
+
+    REQUIRE(a.test(Status::Ready_bit) == true);
+}
+#endif
@@ -0,0 +1,93 @@
+#include "catch2/catch.hpp"
+#include "strong_flags/bulk.hpp"
+#include "test_values.hpp"
+#include <cstdint>
+#include <vector>
+
+STRONG_FLAGS_DEFINE_FLAGS(Bulk8, std::uint8_t, A, B, C, D, E);
+STRONG_FLAGS_DEFINE_FLAGS(Bulk16, std::uint16_t, A, B, C, D, E, F, G, H, I, J);
+STRONG_FLAGS_DEFINE_FLAGS(Bulk32, std::uint32_t, A, B, C, D, E);
+STRONG_FLAGS_DEFINE_FLAGS(Bulk64, std::uint64_t, A, B, C, D, E);
+STRONG_FLAGS_DEFINE_FLAGS(BulkWide, strong_flags::wide, A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, Q, R, S, T, U,
+        V, W, X, Y, Z, A1, B1, C1, D1, E1, F1, G1, H1, I1, J1, K1, L1, M1, N1, O1, P1, Q1, R1, S1, T1, U1, V1, W1,
+        X1, Y1, Z1, A2, B2, C2, D2, E2, F2, G2, H2, I2, J2, K2, L2, M2, N2, O2, P2);
+
+template<typename FlagType>
+void check_bulk(FlagType a, FlagType c) {
+    for (std::size_t count : { std::size_t { 0 }, std::size_t { 1 }, std::size_t { 31 }, std::size_t { 67 },
+            std::size_t { 1000 } }) {
+        auto values = random_flags<FlagType>(12345, count, 128, 5);
+        const auto mask = a | c;
+
+        std::size_t any = 0;
+        std::size_t all = 0;
+        std::vector<std::size_t> expected_all;
+        auto expected_or = FlagType();
+        auto expected_and = ~FlagType();
+        for (std::size_t i = 0; i < count; ++i) {
+            any += values[i].test_any(mask);
+            all += values[i].test_all(mask);
+            if (values[i].test_all(mask)) {
+                expected_all.push_back(i);
+            }
+            expected_or |= values[i];
+            expected_and &= values[i];
+        }
+
+        REQUIRE(strong_flags::bulk::count_any(values.data(), count, mask) == any);
+        REQUIRE(strong_flags::bulk::count_all(values.data(), count, mask) == all);
+        REQUIRE(strong_flags::bulk::count_any(strong_flags::bulk::parallel { 4, 16 }, values.data(), count, mask) == any);
+        REQUIRE(strong_flags::bulk::count_all(strong_flags::bulk::parallel { 4, 16 }, values.data(), count, mask) == all);
+
+        std::vector<std::size_t> indices(count);
+        indices.resize(strong_flags::bulk::select_all(values.data(), count, mask, indices.data()));
+        REQUIRE(indices == expected_all);
+        indices.resize(count);
+        REQUIRE(strong_flags::bulk::select_any(values.data(), count, mask, indices.data()) == any);
+
+        std::vector<std::uint64_t> bitmap((count + 63) / 64, ~0ULL);
+        strong_flags::bulk::select_all_bitmap(values.data(), count, mask, bitmap.data());
+        for (std::size_t i = 0; i < count; ++i) {
+            REQUIRE(((bitmap[i / 64] >> (i % 64)) & 1) == static_cast<std::uint64_t>(values[i].test_all(mask)));
+        }
+        strong_flags::bulk::select_any_bitmap(values.data(), count, mask, bitmap.data());
+        for (std::size_t i = 0; i < count; ++i) {
+            REQUIRE(((bitmap[i / 64] >> (i % 64)) & 1) == static_cast<std::uint64_t>(values[i].test_any(mask)));
+        }
+
+        REQUIRE(strong_flags::bulk::reduce_or(values.data(), count) == expected_or);
+        REQUIRE(strong_flags::bulk::reduce_and(values.data(), count) == expected_and);
+        REQUIRE(strong_flags::bulk::reduce_or(strong_flags::bulk::parallel { 3, 16 }, values.data(), count) == expected_or);
+        REQUIRE(strong_flags::bulk::reduce_and(strong_flags::bulk::parallel { 3, 16 }, values.data(), count)
+                == expected_and);
+
+        auto expected = values;
+        for (auto& value : expected) {
+            value.set(a).toggle(mask).clear(c);
+        }
+        strong_flags::bulk::set(values.data(), count, a);
+        strong_flags::bulk::toggle(strong_flags::bulk::parallel { 2, 16 }, values.data(), count, mask);
+        strong_flags::bulk::clear(values.data(), count, c);
+        REQUIRE(values == expected);
+    }
+}
+
+TEST_CASE("bulk_uint8", "[bulk]") {
+    check_bulk(Bulk8::A, Bulk8::C);
+}
+
+TEST_CASE("bulk_uint16", "[bulk]") {
+    check_bulk(Bulk16::B, Bulk16::E);
+}
+
+TEST_CASE("bulk_uint32", "[bulk]") {
+    check_bulk(Bulk32::A, Bulk32::D);
+}
+
+TEST_CASE("bulk_uint64", "[bulk]") {
+    check_bulk(Bulk64::C, Bulk64::E);
+}
+
+TEST_CASE("bulk_wide", "[bulk]") {
+    check_bulk(BulkWide::A, BulkWide::C);
+}
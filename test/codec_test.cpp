@@ -0,0 +1,161 @@
+#include "catch2/catch.hpp"
+#include "strong_flags/codec.hpp"
+#include "test_values.hpp"
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+STRONG_FLAGS_DEFINE_FLAGS(Event, std::uint16_t, Open, Close, Read, Write, Error, Retry, Flush, Sync, Lock, Unlock);
+STRONG_FLAGS_DEFINE_FLAGS(Renamed, std::uint16_t, Open, Close, Read, Write, Error, Retry, Flush, Sync, Lock, Free);
+STRONG_FLAGS_DEFINE_FLAGS(EventWide, strong_flags::wide, A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, Q, R, S, T, U,
+        V, W, X, Y, Z, A1, B1, C1, D1, E1, F1, G1, H1, I1, J1, K1, L1, M1, N1, O1, P1, Q1, R1, S1, T1, U1, V1, W1,
+        X1, Y1, Z1, A2, B2, C2, D2, E2, F2, G2, H2, I2, J2, K2, L2, M2, N2, O2, P2, Q2, R2, S2, T2, U2, V2, W2, X2);
+
+// Mostly unchanged values, occasionally a single flipped bit or a completely new value.
+template<typename FlagType>
+std::vector<FlagType> make_events(std::size_t count) {
+    std::vector<FlagType> values(count);
+    FlagType current;
+    test_random random { 777 };
+    for (auto& value : values) {
+        const auto r = random.next();
+        const auto choice = r >> 24;
+        if (choice < 24) {
+            current.toggle((r & 0xFFFFFF) % FlagType::bit_count);
+        } else if (choice < 28) {
+            for (typename FlagType::bit_type bit = 0; bit < FlagType::bit_count; ++bit) {
+                if (random.chance(128)) {
+                    current.toggle(bit);
+                }
+            }
+        }
+        value = current;
+    }
+    return values;
+}
+
+template<typename FlagType>
+void check_round_trip(std::size_t count) {
+    const auto values = make_events<FlagType>(count);
+
+    strong_flags::encoder<FlagType> encoder;
+    encoder.push(values.data(), values.size());
+    encoder.finish();
+    REQUIRE(encoder.size() < values.size() * sizeof(FlagType) / 4);
+
+    strong_flags::decoder<FlagType> decoder(encoder.data(), encoder.size());
+    std::vector<FlagType> decoded;
+    REQUIRE(decoder.read_all(decoded) == strong_flags::decode_status::end);
+    REQUIRE(decoded == values);
+
+    std::stringstream stream;
+    REQUIRE(encoder.write_to(stream) == true);
+    REQUIRE(encoder.size() == 0);
+    strong_flags::decoder<FlagType> stream_decoder(stream, 16);
+    std::vector<FlagType> chunk(7);
+    decoded.clear();
+    std::size_t n = 0;
+    while ((n = stream_decoder.read(chunk.data(), chunk.size())) != 0) {
+        decoded.insert(decoded.end(), chunk.begin(), chunk.begin() + static_cast<std::ptrdiff_t>(n));
+    }
+    REQUIRE(stream_decoder.status() == strong_flags::decode_status::end);
+    REQUIRE(decoded == values);
+}
+
+TEST_CASE("codec_round_trip", "[codec]") {
+    check_round_trip<Event::type>(20000);
+    check_round_trip<EventWide::type>(20000);
+}
+
+TEST_CASE("codec_records", "[codec]") {
+    strong_flags::encoder<Event::type> encoder;
+    const auto header = encoder.size();
+
+    encoder.push(Event::Open);
+    REQUIRE(encoder.size() == header + 1);
+    for (int i = 0; i < 1000; ++i) {
+        encoder.push(Event::Open);
+    }
+    REQUIRE(encoder.size() == header + 1);
+    encoder.finish();
+    REQUIRE(encoder.size() == header + 4);
+    encoder.push(Event::Open | Event::Close | Event::Write);
+    REQUIRE(encoder.size() == header + 6);
+
+    strong_flags::decoder<Event::type> decoder(encoder.data(), encoder.size());
+    std::vector<Event::type> decoded;
+    REQUIRE(decoder.read_all(decoded) == strong_flags::decode_status::end);
+    REQUIRE(decoded.size() == 1002);
+    REQUIRE(decoded[1000] == Event::Open);
+    REQUIRE(decoded[1001] == (Event::Open | Event::Close | Event::Write));
+}
+
+TEST_CASE("codec_streaming", "[codec]") {
+    const auto values = make_events<Event::type>(5000);
+
+    strong_flags::encoder<Event::type> encoder;
+    std::stringstream stream;
+    for (std::size_t i = 0; i < values.size(); i += 100) {
+        encoder.push(values.data() + i, 100);
+        REQUIRE(encoder.write_to(stream) == true);
+    }
+    encoder.finish();
+    REQUIRE(encoder.write_to(stream) == true);
+
+    strong_flags::decoder<Event::type> decoder(stream, 64);
+    std::vector<Event::type> decoded(1000);
+    REQUIRE(decoder.read(decoded.data(), decoded.size()) == decoded.size());
+
+    // The moved-to decoder continues inside the chunk the first one had buffered.
+    auto moved = std::move(decoder);
+    REQUIRE(moved.read_all(decoded) == strong_flags::decode_status::end);
+    REQUIRE(decoded == values);
+
+    static_assert(!std::is_copy_constructible<strong_flags::decoder<Event::type>>::value, "");
+    static_assert(std::is_nothrow_move_constructible<strong_flags::decoder<Event::type>>::value, "");
+}
+
+TEST_CASE("codec_errors", "[codec]") {
+    strong_flags::encoder<Event::type> encoder;
+    encoder.push(Event::Open | Event::Lock);
+    encoder.push(Event::Unlock);
+    encoder.finish();
+    const std::vector<std::uint8_t> bytes(encoder.data(), encoder.data() + encoder.size());
+    Event::type out[4];
+
+    strong_flags::decoder<Renamed::type> renamed(bytes.data(), bytes.size());
+    REQUIRE(renamed.status() == strong_flags::decode_status::type_mismatch);
+    Renamed::type renamed_out[4];
+    REQUIRE(renamed.read(renamed_out, 4) == 0);
+
+    strong_flags::decoder<EventWide::type> wide(bytes.data(), bytes.size());
+    REQUIRE(wide.status() == strong_flags::decode_status::type_mismatch);
+
+    auto broken = bytes;
+    broken[0] = 'X';
+    strong_flags::decoder<Event::type> bad_magic(broken.data(), broken.size());
+    REQUIRE(bad_magic.status() == strong_flags::decode_status::bad_header);
+
+    strong_flags::decoder<Event::type> truncated(bytes.data(), bytes.size() - 1);
+    REQUIRE(truncated.read(out, 4) == 1);
+    REQUIRE(truncated.status() == strong_flags::decode_status::corrupt);
+
+    broken = bytes;
+    broken.push_back(1 | (40 << 2));
+    strong_flags::decoder<Event::type> out_of_range(broken.data(), broken.size());
+    REQUIRE(out_of_range.read(out, 4) == 2);
+    REQUIRE(out[1] == Event::Unlock);
+    REQUIRE(out_of_range.status() == strong_flags::decode_status::corrupt);
+
+    broken = bytes;
+    broken.push_back(3);
+    strong_flags::decoder<Event::type> bad_kind(broken.data(), broken.size());
+    REQUIRE(bad_kind.read(out, 4) == 2);
+    REQUIRE(bad_kind.status() == strong_flags::decode_status::corrupt);
+
+    strong_flags::decoder<Event::type> empty(bytes.data(), 3);
+    REQUIRE(empty.status() == strong_flags::decode_status::bad_header);
+}
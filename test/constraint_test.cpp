@@ -0,0 +1,93 @@
+#include "catch2/catch.hpp"
+#include "strong_flags/constraint.hpp"
+#include <cstdint>
+#include <vector>
+
+STRONG_FLAGS_DEFINE_FLAGS(Access, std::uint8_t, Read, Write, Append, Trunc, Create, Text, Binary);
+STRONG_FLAGS_DEFINE_FLAGS(Access16, std::uint16_t, Read, Write, Append, Trunc, Create, Text, Binary);
+STRONG_FLAGS_DEFINE_FLAGS(Access64, std::uint64_t, Read, Write, Append, Trunc, Create, Text, Binary);
+STRONG_FLAGS_DEFINE_FLAGS(AccessWide, strong_flags::wide, Read, Write, Append, Trunc, Create, Text, Binary, P7, P8,
+        P9, P10, P11, P12, P13, P14, P15, P16, P17, P18, P19, P20, P21, P22, P23, P24, P25, P26, P27, P28, P29, P30,
+        P31, P32, P33, P34, P35, P36, P37, P38, P39, P40, P41, P42, P43, P44, P45, P46, P47, P48, P49, P50, P51, P52,
+        P53, P54, P55, P56, P57, P58, P59, P60, P61, P62, P63, P64, P65, P66, P67, P68, P69, P70);
+STRONG_FLAGS_DEFINE_FLAGS(Free, std::uint16_t, A, B);
+
+// Append and Trunc exclude each other and both need Write, Create needs Write, a file is either text or
+// binary.
+#define ACCESS_CONSTRAINTS(name)                                                                            \
+    STRONG_FLAGS_DEFINE_CONSTRAINTS(name::type,                                                             \
+            strong_flags::exclusive<name::Append_bit, name::Trunc_bit>,                                     \
+            strong_flags::implies<name::Append_bit, name::Write_bit>,                                       \
+            strong_flags::implies<name::Trunc_bit, name::Write_bit>,                                        \
+            strong_flags::implies<name::Create_bit, name::Write_bit>,                                       \
+            strong_flags::one_of<name::Text_bit, name::Binary_bit>)
+
+ACCESS_CONSTRAINTS(Access);
+ACCESS_CONSTRAINTS(Access16);
+ACCESS_CONSTRAINTS(Access64);
+ACCESS_CONSTRAINTS(AccessWide);
+
+constexpr auto s_open = strong_flags::checked(Access::Read | Access::Write | Access::Trunc | Access::Binary);
+
+static_assert(strong_flags::is_valid(s_open), "");
+static_assert(strong_flags::is_valid(Access::Read | Access::Text), "");
+static_assert(!strong_flags::is_valid(Access::Read), "");
+static_assert(!strong_flags::is_valid(Access::Read | Access::Text | Access::Binary), "");
+static_assert(!strong_flags::is_valid(Access::Write | Access::Append | Access::Trunc | Access::Text), "");
+static_assert(!strong_flags::is_valid(Access::Create | Access::Text), "");
+static_assert(strong_flags::is_valid(Free::type()), "");
+
+// Same rules as the constraints above, one value at a time.
+bool valid_by_hand(unsigned bits) {
+    const bool write = bits & 2, append = bits & 4, trunc = bits & 8, create = bits & 16;
+    const bool text = bits & 32, binary = bits & 64;
+    return !(append && trunc) && (!append || write) && (!trunc || write) && (!create || write) && (text != binary);
+}
+
+template<typename FlagType>
+std::vector<FlagType> all_values(std::size_t repeat) {
+    std::vector<FlagType> values;
+    for (std::size_t r = 0; r < repeat; ++r) {
+        for (unsigned bits = 0; bits < 128; ++bits) {
+            FlagType value;
+            for (unsigned bit = 0; bit < 7; ++bit) {
+                if ((bits >> bit) & 1) {
+                    value.set(bit);
+                }
+            }
+            values.push_back(value);
+        }
+    }
+    return values;
+}
+
+template<typename FlagType>
+void check_select_invalid() {
+    // 3 * 128 + 5 values, so vector blocks and a scalar tail both run.
+    auto values = all_values<FlagType>(4);
+    values.resize(3 * 128 + 5);
+
+    std::vector<std::size_t> expected;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        REQUIRE(strong_flags::is_valid(values[i]) == valid_by_hand(static_cast<unsigned>(i % 128)));
+        if (!valid_by_hand(static_cast<unsigned>(i % 128))) {
+            expected.push_back(i);
+        }
+    }
+
+    std::vector<std::size_t> indices(values.size());
+    const auto n = strong_flags::bulk::select_invalid(values.data(), values.size(), indices.data());
+    indices.resize(n);
+    REQUIRE(indices == expected);
+}
+
+TEST_CASE("constraint_select_invalid", "[constraint]") {
+    check_select_invalid<Access::type>();
+    check_select_invalid<Access16::type>();
+    check_select_invalid<Access64::type>();
+    check_select_invalid<AccessWide::type>();
+
+    const Free::type free[] = { Free::A, Free::A | Free::B };
+    std::size_t indices[2];
+    REQUIRE(strong_flags::bulk::select_invalid(free, 2, indices) == 0);
+}
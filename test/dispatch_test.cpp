@@ -0,0 +1,110 @@
+#include "catch2/catch.hpp"
+#include "strong_flags/dispatch.hpp"
+#include "test_values.hpp"
+#include <cstdint>
+#include <vector>
+
+STRONG_FLAGS_DEFINE_FLAGS(Mode, std::uint8_t, Read, Write, Exec, Append, Create, Trunc);
+STRONG_FLAGS_DEFINE_FLAGS(Signals, strong_flags::wide, S0, S1, S2, S3, S4, S5, S6, S7, S8, S9, S10, S11, S12, S13,
+        S14, S15, S16, S17, S18, S19, S20, S21, S22, S23, S24, S25, S26, S27, S28, S29, S30, S31, S32, S33, S34,
+        S35, S36, S37, S38, S39, S40, S41, S42, S43, S44, S45, S46, S47, S48, S49, S50, S51, S52, S53, S54, S55,
+        S56, S57, S58, S59, S60, S61, S62, S63, S64, S65, S66, S67, S68, S69, S70, S71, S72, S73, S74, S75, S76,
+        S77, S78, S79);
+
+TEST_CASE("dispatch_table", "[dispatch]") {
+    for (unsigned v = 0; v < 64; ++v) {
+        const auto value = Mode::from_underlying_type(static_cast<std::uint8_t>(v));
+
+        int expected = 0;
+        if (value.test_all(Mode::Write | Mode::Trunc)) {
+            expected = 1;
+        } else if (value.test_any(Mode::Write | Mode::Append)) {
+            expected = 2;
+        } else if (value.test_any(Mode::Exec)) {
+            expected = 3;
+        } else {
+            expected = 4;
+        }
+
+        const int res = strong_flags::dispatch(value,
+                strong_flags::when_all<Mode::Write_bit, Mode::Trunc_bit>([] { return 1; }),
+                strong_flags::when_any<Mode::Write_bit, Mode::Append_bit>([] { return 2; }),
+                strong_flags::when_any<Mode::Exec_bit>([](const Mode::type& m) {
+                    return m.test(Mode::Exec_bit) ? 3 : -1;
+                }),
+                strong_flags::otherwise([] { return 4; }));
+        REQUIRE(res == expected);
+
+        // Non-contiguous bits and no otherwise: unmatched values give a value-initialized result.
+        const int sparse = strong_flags::dispatch(value,
+                strong_flags::when_any<Mode::Read_bit>([] { return 1; }),
+                strong_flags::when_all<Mode::Create_bit, Mode::Trunc_bit>([] { return 2; }));
+        REQUIRE(sparse == (value.test(Mode::Read_bit) ? 1 : value.test_all(Mode::Create | Mode::Trunc) ? 2 : 0));
+    }
+
+    int calls = 0;
+    strong_flags::dispatch(Mode::Read | Mode::Exec,
+            strong_flags::when_any<Mode::Exec_bit>([&calls] { ++calls; }),
+            strong_flags::otherwise([&calls] { calls += 10; }));
+    REQUIRE(calls == 1);
+}
+
+TEST_CASE("dispatch_many_bits", "[dispatch]") {
+    const auto values = random_flags<Signals::type>(4242, 500, 12);
+    for (const auto& value : values) {
+        // Only when_any cases over more bits than the jump table covers: one pass over the set bits.
+        int expected = 0;
+        if (value.test_any(Signals::S70 | Signals::S3)) {
+            expected = 1;
+        } else if (value.test_any(Signals::S0 | Signals::S1 | Signals::S2 | Signals::S65 | Signals::S66)) {
+            expected = 2;
+        } else if (value.test_any(Signals::S10 | Signals::S11 | Signals::S79)) {
+            expected = 3;
+        } else {
+            expected = 4;
+        }
+        const int any_res = strong_flags::dispatch(value,
+                strong_flags::when_any<Signals::S70_bit, Signals::S3_bit>([] { return 1; }),
+                strong_flags::when_any<Signals::S0_bit, Signals::S1_bit, Signals::S2_bit, Signals::S65_bit,
+                        Signals::S66_bit>([] { return 2; }),
+                strong_flags::when_any<Signals::S10_bit, Signals::S11_bit, Signals::S79_bit>([] { return 3; }),
+                strong_flags::otherwise([] { return 4; }));
+        REQUIRE(any_res == expected);
+
+        // when_all over many bits: cases are tested in order.
+        if (value.test_all(Signals::S5 | Signals::S6)) {
+            expected = 1;
+        } else if (value.test_any(Signals::S20 | Signals::S21 | Signals::S22 | Signals::S23 | Signals::S24)) {
+            expected = 2;
+        } else if (value.test_all(Signals::S40 | Signals::S41)) {
+            expected = 3;
+        } else {
+            expected = 0;
+        }
+        const int all_res = strong_flags::dispatch(value,
+                strong_flags::when_all<Signals::S5_bit, Signals::S6_bit>([] { return 1; }),
+                strong_flags::when_any<Signals::S20_bit, Signals::S21_bit, Signals::S22_bit, Signals::S23_bit,
+                        Signals::S24_bit>([] { return 2; }),
+                strong_flags::when_all<Signals::S40_bit, Signals::S41_bit>([] { return 3; }));
+        REQUIRE(all_res == expected);
+    }
+}
+
+TEST_CASE("dispatch_each", "[dispatch]") {
+    std::vector<int> seen;
+    const auto record = [&seen](Mode::type::bit_type bit) {
+        seen.push_back(static_cast<int>(bit));
+    };
+
+    strong_flags::dispatch_each(Mode::Read | Mode::Exec | Mode::Trunc | Mode::Create,
+            strong_flags::on_bit<Mode::Trunc_bit>(record),
+            strong_flags::on_bit<Mode::Read_bit>(record),
+            strong_flags::on_bit<Mode::Exec_bit>([&seen] { seen.push_back(100); }));
+    REQUIRE(seen == std::vector<int> { 0, 100, 5 });
+
+    std::size_t wide_calls = 0;
+    strong_flags::dispatch_each(Signals::S1 | Signals::S64 | Signals::S79,
+            strong_flags::on_bit<Signals::S79_bit>([&wide_calls](std::size_t bit) { wide_calls += bit; }),
+            strong_flags::on_bit<Signals::S64_bit>([&wide_calls](std::size_t bit) { wide_calls += bit; }));
+    REQUIRE(wide_calls == 79 + 64);
+}
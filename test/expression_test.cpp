@@ -0,0 +1,68 @@
+#include "catch2/catch.hpp"
+#include "strong_flags/expression.hpp"
+#include "test_values.hpp"
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+STRONG_FLAGS_DEFINE_FLAGS(Lazy, std::uint8_t, A, B, C, D, E);
+STRONG_FLAGS_DEFINE_FLAGS(LazyWide, strong_flags::wide, A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, Q, R, S, T,
+        U, V, W, X, Y, Z, A1, B1, C1, D1, E1, F1, G1, H1, I1, J1, K1, L1, M1, N1, O1, P1, Q1, R1, S1, T1, U1, V1, W1,
+        X1, Y1, Z1, A2, B2, C2, D2, E2, F2, G2, H2, I2, J2, K2, L2, M2, N2, O2, P2, Q2, R2, S2, T2, U2, V2, W2, X2,
+        Y2, Z2);
+
+using strong_flags::lazy;
+
+constexpr Lazy::type s_fused = (lazy(Lazy::A) & ~Lazy::B) | (Lazy::C ^ lazy(Lazy::A | Lazy::C));
+static_assert(s_fused == Lazy::A, "");
+static_assert(Lazy::type(~lazy(Lazy::A)) == (Lazy::B | Lazy::C | Lazy::D | Lazy::E), "");
+static_assert(!(lazy(Lazy::A) & Lazy::B).any(), "");
+static_assert(std::is_same<decltype(lazy(Lazy::A) | Lazy::B),
+        strong_flags::binary_expression<strong_flags::detail::expression_or,
+        strong_flags::value_expression<Lazy::type>, strong_flags::value_expression<Lazy::type>>>::value, "");
+
+constexpr LazyWide::type s_wide = ~lazy(LazyWide::A) & (LazyWide::B | lazy(LazyWide::Z2));
+static_assert(s_wide == (LazyWide::B | LazyWide::Z2), "");
+
+template<typename FlagType>
+void check_expressions() {
+    const auto values = random_flags<FlagType>(17, 64);
+    for (std::size_t i = 0; i + 3 < values.size(); ++i) {
+        const auto& a = values[i];
+        const auto& b = values[i + 1];
+        const auto& c = values[i + 2];
+        const auto& d = values[i + 3];
+
+        const FlagType fused = (lazy(a) & ~lazy(b)) | (lazy(c) ^ d);
+        REQUIRE(fused == ((a & ~b) | (c ^ d)));
+        REQUIRE((~(lazy(a) | b)).eval() == ~(a | b));
+        REQUIRE((~~lazy(a)).eval() == a);
+        REQUIRE((lazy(a) & b).any() == a.test_any(b));
+        REQUIRE((lazy(a) & ~c).empty() == (a & ~c).empty());
+    }
+}
+
+TEST_CASE("expression_eval", "[expression]") {
+    check_expressions<Lazy::type>();
+    check_expressions<LazyWide::type>();
+}
+
+template<typename FlagType>
+void check_bulk_assign() {
+    auto a = random_flags<FlagType>(17, 1000);
+    const auto b = random_flags<FlagType>(18, 1001);
+    const auto mask = FlagType::from_bit(1) | FlagType::from_bit(3);
+
+    std::vector<FlagType> expected(a.size());
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        expected[i] = (a[i] & ~b[i + 1]) | mask;
+    }
+    const auto expr = (strong_flags::lazy_array(a.data()) & ~strong_flags::lazy_array(b.data() + 1)) | mask;
+    strong_flags::bulk::assign(a.data(), a.size(), expr);
+    REQUIRE(a == expected);
+}
+
+TEST_CASE("expression_bulk_assign", "[expression]") {
+    check_bulk_assign<Lazy::type>();
+    check_bulk_assign<LazyWide::type>();
+}
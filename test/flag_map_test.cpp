@@ -0,0 +1,128 @@
+#include "catch2/catch.hpp"
+#include "strong_flags/flag_map.hpp"
+#include "test_values.hpp"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+STRONG_FLAGS_DEFINE_FLAGS(Mode, std::uint8_t, Read, Write, Exec);
+STRONG_FLAGS_DEFINE_FLAGS(Mode32, std::uint32_t, A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, Q);
+STRONG_FLAGS_DEFINE_FLAGS(ModeWide, strong_flags::wide, A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, Q, R, S, T,
+        U, V, W, X, Y, Z, A1, B1, C1, D1, E1, F1, G1, H1, I1, J1, K1, L1, M1, N1, O1, P1, Q1, R1, S1, T1, U1, V1, W1,
+        X1, Y1, Z1, A2, B2, C2, D2, E2, F2, G2, H2, I2, J2, K2, L2, M2, N2);
+
+STRONG_FLAGS_DEFINE_HASH(Mode::type);
+STRONG_FLAGS_DEFINE_HASH(ModeWide::type);
+
+static_assert(strong_flags::flag_map<Mode::type, int>::is_dense, "");
+static_assert(!strong_flags::flag_map<Mode32::type, int>::is_dense, "");
+static_assert(!strong_flags::flag_map<ModeWide::type, int>::is_dense, "");
+
+constexpr strong_flags::flag_map<Mode::type, int> s_costs {
+    { Mode::Read, 1 },
+    { Mode::Read | Mode::Write, 3 },
+    { Mode::Exec, 5 },
+};
+
+static_assert(s_costs.size() == 3, "");
+static_assert(*s_costs.find(Mode::Read | Mode::Write) == 3, "");
+static_assert(s_costs.find(Mode::Write) == nullptr, "");
+
+TEST_CASE("flag_map_std_hash", "[flag_map]") {
+    std::unordered_map<Mode::type, std::string> names;
+    names[Mode::Read] = "r";
+    names[Mode::Read | Mode::Exec] = "rx";
+    REQUIRE(names.at(Mode::Read | Mode::Exec) == "rx");
+    REQUIRE(names.count(Mode::Write) == 0);
+
+    std::unordered_set<ModeWide::type> wide { ModeWide::A, ModeWide::N2, ModeWide::A | ModeWide::N2 };
+    REQUIRE(wide.size() == 3);
+    REQUIRE(wide.count(ModeWide::N2) == 1);
+
+    REQUIRE(std::hash<Mode::type> { }(Mode::Read) == strong_flags::hash<Mode::type> { }(Mode::Read));
+    REQUIRE(std::hash<Mode::type> { }(Mode::Read) != std::hash<Mode::type> { }(Mode::Write));
+}
+
+TEST_CASE("flag_map_dense", "[flag_map]") {
+    auto map = s_costs;
+    std::vector<std::pair<unsigned, int>> items;
+    for (auto [key, value] : map) {
+        items.emplace_back(key.to_underlying_type(), value);
+    }
+    REQUIRE(items == std::vector<std::pair<unsigned, int>> { { 1, 1 }, { 3, 3 }, { 4, 5 } });
+
+    REQUIRE(map.insert(Mode::Read, 10) == false);
+    REQUIRE(map.insert_or_assign(Mode::Read, 10) == false);
+    REQUIRE(*map.find(Mode::Read) == 10);
+    map[Mode::Write] += 7;
+    REQUIRE(map.size() == 4);
+    REQUIRE(map[Mode::Write] == 7);
+    REQUIRE(map.erase(Mode::Exec) == true);
+    REQUIRE(map.erase(Mode::Exec) == false);
+    REQUIRE(!map.contains(Mode::Exec));
+    REQUIRE(map.size() == 3);
+
+    map.clear();
+    REQUIRE(map.empty());
+    REQUIRE(map.begin() == map.end());
+}
+
+template<typename FlagType>
+void check_hashed(std::size_t count) {
+    strong_flags::flag_map<FlagType, std::size_t> map;
+    std::vector<FlagType> keys;
+    const auto candidates = random_flags<FlagType>(5, count, 32);
+    for (std::size_t i = 0; i < count; ++i) {
+        if (map.insert(candidates[i], i)) {
+            keys.push_back(candidates[i]);
+        }
+    }
+    REQUIRE(map.size() == keys.size());
+
+    // Every other key goes; backward shifting must keep the rest reachable.
+    std::size_t erased = 0;
+    for (std::size_t i = 0; i < keys.size(); i += 2) {
+        REQUIRE(map.erase(keys[i]));
+        ++erased;
+    }
+    REQUIRE(map.size() == keys.size() - erased);
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        REQUIRE(map.contains(keys[i]) == (i % 2 == 1));
+    }
+
+    std::vector<FlagType> remaining;
+    for (const auto& entry : map) {
+        REQUIRE(entry.value == *map.find(entry.key));
+        remaining.push_back(entry.key);
+    }
+    REQUIRE(remaining.size() == map.size());
+    for (std::size_t i = 1; i < remaining.size(); ++i) {
+        REQUIRE(strong_flags::detail::flag_less(remaining[i - 1], remaining[i]));
+    }
+}
+
+TEST_CASE("flag_map_hashed", "[flag_map]") {
+    for (std::size_t count : { 0, 1, 50, 3000 }) {
+        check_hashed<Mode32::type>(count);
+        check_hashed<ModeWide::type>(count);
+    }
+
+    strong_flags::flag_map<ModeWide::type, int> map { { ModeWide::N2, 2 }, { ModeWide::A, 1 } };
+    map[ModeWide::B] = 3;
+    std::vector<int> values;
+    for (auto [key, value] : map) {
+        values.push_back(value);
+    }
+    REQUIRE(values == std::vector<int> { 1, 3, 2 });
+
+    // The order is rebuilt after a change.
+    map.erase(ModeWide::B);
+    map[ModeWide::C] = 4;
+    values.clear();
+    for (auto [key, value] : map) {
+        values.push_back(value);
+    }
+    REQUIRE(values == std::vector<int> { 1, 4, 2 });
+}
@@ -0,0 +1,79 @@
+#include "catch2/catch.hpp"
+#include "strong_flags/format.hpp"
+#include <string>
+
+STRONG_FLAGS_DEFINE_FLAGS(Color, unsigned char, Red, Green, Blue);
+
+STRONG_FLAGS_DEFINE_FLAGS(Many, strong_flags::wide, Flag0, Flag1, Flag2, Flag3, Flag4, Flag5, Flag6, Flag7, Flag8,
+        Flag9, Flag10, Flag11, Flag12, Flag13, Flag14, Flag15, Flag16, Flag17, Flag18, Flag19, Flag20, Flag21,
+        Flag22, Flag23, Flag24, Flag25, Flag26, Flag27, Flag28, Flag29, Flag30, Flag31, Flag32, Flag33, Flag34,
+        Flag35, Flag36, Flag37, Flag38, Flag39, Flag40, Flag41, Flag42, Flag43, Flag44, Flag45, Flag46, Flag47,
+        Flag48, Flag49, Flag50, Flag51, Flag52, Flag53, Flag54, Flag55, Flag56, Flag57, Flag58, Flag59, Flag60,
+        Flag61, Flag62, Flag63, Flag64, Flag65, Flag66, Flag67, Flag68, Flag69, Flag70, Flag71, Flag72, Flag73,
+        Flag74, Flag75, Flag76, Flag77, Flag78, Flag79, Flag80, Flag81, Flag82, Flag83, Flag84, Flag85, Flag86,
+        Flag87, Flag88, Flag89, Flag90, Flag91, Flag92, Flag93, Flag94, Flag95, Flag96, Flag97, Flag98, Flag99,
+        Flag100, Flag101, Flag102, Flag103, Flag104, Flag105, Flag106, Flag107, Flag108, Flag109, Flag110, Flag111,
+        Flag112, Flag113, Flag114, Flag115, Flag116, Flag117, Flag118, Flag119, Flag120, Flag121, Flag122, Flag123,
+        Flag124, Flag125, Flag126, Flag127, Flag128, Flag129, Flag130, Flag131, Flag132, Flag133, Flag134, Flag135,
+        Flag136, Flag137, Flag138, Flag139, Flag140, Flag141, Flag142, Flag143, Flag144, Flag145, Flag146, Flag147,
+        Flag148, Flag149, Flag150, Flag151, Flag152, Flag153, Flag154, Flag155, Flag156, Flag157, Flag158, Flag159,
+        Flag160, Flag161, Flag162, Flag163, Flag164, Flag165, Flag166, Flag167, Flag168, Flag169, Flag170, Flag171,
+        Flag172, Flag173, Flag174, Flag175, Flag176, Flag177, Flag178, Flag179, Flag180, Flag181, Flag182, Flag183,
+        Flag184, Flag185, Flag186, Flag187, Flag188, Flag189, Flag190, Flag191, Flag192, Flag193, Flag194, Flag195,
+        Flag196, Flag197, Flag198, Flag199);
+
+TEST_CASE("name_table", "[format]") {
+    REQUIRE(Color::type::names.size() == 3);
+    REQUIRE(Color::type::names[Color::Red_bit] == "Red");
+    REQUIRE(Color::type::names[Color::Blue_bit] == "Blue");
+    REQUIRE(Many::type::names[0] == "Flag0");
+    REQUIRE(Many::type::names[199] == "Flag199");
+
+    REQUIRE(strong_flags::name_of<Color::type>(Color::Green_bit) == "Green");
+    REQUIRE(strong_flags::name_of<Color::type>(3).empty() == true);
+
+    static_assert(Color::type::names[1] == "Green", "");
+}
+
+TEST_CASE("format_to", "[format]") {
+    char buffer[32];
+
+    REQUIRE(strong_flags::format_to(buffer, sizeof(buffer), Color::Red | Color::Blue) == 8);
+    REQUIRE(std::string(buffer) == "Red|Blue");
+
+    REQUIRE(strong_flags::format_to(buffer, sizeof(buffer), ~Color::type(), ", ") == 16);
+    REQUIRE(std::string(buffer) == "Red, Green, Blue");
+
+    REQUIRE(strong_flags::format_to(buffer, sizeof(buffer), Color::type()) == 0);
+    REQUIRE(std::string(buffer).empty());
+
+    REQUIRE(strong_flags::format_to(buffer, 5, Color::Red | Color::Blue) == 8);
+    REQUIRE(std::string(buffer) == "Red|");
+
+    REQUIRE(strong_flags::format_to(buffer, sizeof(buffer), Many::Flag3 | Many::Flag150) == 13);
+    REQUIRE(std::string(buffer) == "Flag3|Flag150");
+}
+
+TEST_CASE("parse", "[format]") {
+    REQUIRE(strong_flags::parse<Color::type>("Red|Blue") == (Color::Red | Color::Blue));
+    REQUIRE(strong_flags::parse<Color::type>(" Green , Red ", ",") == (Color::Red | Color::Green));
+    REQUIRE(strong_flags::parse<Color::type>("") == Color::type());
+    REQUIRE(strong_flags::parse<Color::type>("Blue") == Color::Blue);
+    REQUIRE(strong_flags::parse<Color::type>("Red|Yellow").has_value() == false);
+    REQUIRE(strong_flags::parse<Color::type>("Red||Blue").has_value() == false);
+    REQUIRE(strong_flags::parse<Color::type>("red").has_value() == false);
+
+    for (Many::type::bit_type bit = 0; bit < Many::type::bit_count; ++bit) {
+        REQUIRE(strong_flags::find_bit<Many::type>(Many::type::names[bit]) == bit);
+    }
+    REQUIRE(strong_flags::find_bit<Many::type>("Flag200") == Many::type::bit_count);
+    REQUIRE(strong_flags::find_bit<Many::type>("") == Many::type::bit_count);
+
+    char buffer[64];
+    const auto value = Many::Flag0 | Many::Flag64 | Many::Flag199;
+    strong_flags::format_to(buffer, sizeof(buffer), value);
+    REQUIRE(strong_flags::parse<Many::type>(buffer) == value);
+
+    static_assert(*strong_flags::parse<Color::type>("Green|Blue") == (Color::Green | Color::Blue), "");
+    static_assert(strong_flags::find_bit<Color::type>("Blue") == Color::Blue_bit, "");
+}
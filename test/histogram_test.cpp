@@ -0,0 +1,104 @@
+#include "catch2/catch.hpp"
+#include "strong_flags/histogram.hpp"
+#include "test_values.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+STRONG_FLAGS_DEFINE_FLAGS(Hist8, std::uint8_t, A, B, C, D, E);
+STRONG_FLAGS_DEFINE_FLAGS(Hist16, std::uint16_t, A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P);
+STRONG_FLAGS_DEFINE_FLAGS(Hist32, std::uint32_t, A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, Q, R, S, T);
+STRONG_FLAGS_DEFINE_FLAGS(Hist64, std::uint64_t, A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, Q, R, S, T, U,
+        V, W, X, Y, Z, A1, B1, C1, D1, E1, F1, G1, H1, I1, J1, K1, L1, M1, N1, O1, P1, Q1, R1, S1, T1, U1, V1, W1,
+        X1, Y1, Z1, A2, B2, C2, D2, E2, F2, G2, H2, I2, J2, K2, L2);
+STRONG_FLAGS_DEFINE_FLAGS(HistWide, strong_flags::wide, A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, Q, R, S, T,
+        U, V, W, X, Y, Z, A1, B1, C1, D1, E1, F1, G1, H1, I1, J1, K1, L1, M1, N1, O1, P1, Q1, R1, S1, T1, U1, V1,
+        W1, X1, Y1, Z1, A2, B2, C2, D2, E2, F2, G2, H2, I2, J2, K2, L2, M2, N2, O2, P2, Q2, R2, S2, T2, U2);
+
+// Bit i is set with a probability that grows with i, so every position gets a distinct count.
+template<typename FlagType>
+std::vector<FlagType> skewed_values(std::size_t count) {
+    std::vector<FlagType> values(count);
+    test_random random { 99 };
+    for (auto& value : values) {
+        for (typename FlagType::bit_type bit = 0; bit < FlagType::bit_count; ++bit) {
+            if (random.chance(static_cast<std::uint32_t>(3 * bit + 10))) {
+                value.set(bit);
+            }
+        }
+    }
+    return values;
+}
+
+template<typename FlagType>
+void check_histogram(std::size_t count) {
+    const auto values = skewed_values<FlagType>(count);
+
+    std::vector<std::uint64_t> expected(FlagType::bit_count);
+    for (const auto& value : values) {
+        for (typename FlagType::bit_type bit = 0; bit < FlagType::bit_count; ++bit) {
+            expected[bit] += value.test(bit) ? 1 : 0;
+        }
+    }
+
+    strong_flags::histogram<FlagType> h;
+    h.add(values.data(), values.size());
+    REQUIRE(h.total() == count);
+    REQUIRE(std::vector<std::uint64_t>(h.counts().begin(), h.counts().end()) == expected);
+
+    strong_flags::histogram<FlagType> incremental;
+    const std::size_t half = count / 3;
+    incremental.add(values.data(), half);
+    for (std::size_t i = half; i < count; ++i) {
+        incremental.add(values[i]);
+    }
+    REQUIRE(incremental.counts() == h.counts());
+    REQUIRE(incremental.total() == count);
+
+    strong_flags::histogram<FlagType> parallel;
+    parallel.add(strong_flags::bulk::parallel { 4, 1000 }, values.data(), values.size());
+    REQUIRE(parallel.counts() == h.counts());
+    REQUIRE(parallel.total() == count);
+}
+
+TEST_CASE("histogram_counts", "[histogram]") {
+    for (std::size_t count : { 0, 1, 15, 17, 100, 1000, 70001 }) {
+        check_histogram<Hist8::type>(count);
+        check_histogram<Hist16::type>(count);
+        check_histogram<Hist32::type>(count);
+        check_histogram<Hist64::type>(count);
+        check_histogram<HistWide::type>(count);
+    }
+}
+
+TEST_CASE("histogram_merge", "[histogram]") {
+    strong_flags::histogram<Hist8::type> a;
+    strong_flags::histogram<Hist8::type> b;
+    a.add(Hist8::A | Hist8::C);
+    a.add(Hist8::C);
+    b.add(Hist8::E);
+
+    a.merge(b);
+    REQUIRE(a.total() == 3);
+    REQUIRE(a[Hist8::A_bit] == 1);
+    REQUIRE(a[Hist8::B_bit] == 0);
+    REQUIRE(a[Hist8::C_bit] == 2);
+    REQUIRE(a[Hist8::E_bit] == 1);
+
+    a.clear();
+    REQUIRE(a.total() == 0);
+    REQUIRE(a[Hist8::C_bit] == 0);
+}
+
+TEST_CASE("histogram_names", "[histogram]") {
+    strong_flags::histogram<Hist8::type> h;
+    h.add(Hist8::B | Hist8::D);
+    h.add(Hist8::D);
+
+    std::string out;
+    h.for_each([&out](std::string_view name, std::uint64_t count) {
+        out += std::string(name) + "=" + std::to_string(count) + ";";
+    });
+    REQUIRE(out == "A=0;B=1;C=0;D=2;E=0;");
+    REQUIRE(strong_flags::histogram<HistWide::type>::name(HistWide::U2_bit) == "U2");
+}
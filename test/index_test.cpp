@@ -0,0 +1,200 @@
+#include "catch2/catch.hpp"
+#include "strong_flags/index.hpp"
+#include "test_values.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+STRONG_FLAGS_DEFINE_FLAGS(Record, std::uint8_t, A, B, C, D, E);
+STRONG_FLAGS_DEFINE_FLAGS(RecordWide, strong_flags::wide, A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, Q, R, S,
+        T, U, V, W, X, Y, Z, A1, B1, C1, D1, E1, F1, G1, H1, I1, J1, K1, L1, M1, N1, O1, P1, Q1, R1, S1, T1, U1, V1,
+        W1, X1, Y1, Z1, A2, B2, C2, D2, E2, F2, G2, H2, I2, J2, K2, L2, M2);
+
+// Random rows whose density varies with the row id, so both array and bitmap containers appear.
+std::set<std::uint32_t> make_rows(std::uint32_t seed, std::size_t count) {
+    std::set<std::uint32_t> rows;
+    test_random random { seed };
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::uint32_t r = random.next();
+        const std::uint32_t high = (r >> 28) % 3;
+        const std::uint32_t span = high == 1 ? 6000 : 1 << 16;
+        rows.insert((high << 16) | ((r & 0xFFFFFF) % span));
+    }
+    return rows;
+}
+
+strong_flags::row_set to_row_set(const std::set<std::uint32_t>& rows) {
+    strong_flags::row_set res;
+    for (auto row : rows) {
+        res.insert(row);
+    }
+    return res;
+}
+
+TEST_CASE("row_set_basic", "[index]") {
+    strong_flags::row_set rows;
+    REQUIRE(rows.empty());
+    REQUIRE(rows.begin() == rows.end());
+
+    REQUIRE(rows.insert(70000) == true);
+    REQUIRE(rows.insert(5) == true);
+    REQUIRE(rows.insert(5) == false);
+    REQUIRE(rows.insert(6) == true);
+    REQUIRE(rows.size() == 3);
+    REQUIRE(rows.contains(6));
+    REQUIRE(!rows.contains(7));
+    REQUIRE(rows.to_vector() == std::vector<std::uint32_t> { 5, 6, 70000 });
+
+    REQUIRE(rows.erase(70000) == true);
+    REQUIRE(rows.erase(70000) == false);
+    REQUIRE(std::vector<std::uint32_t>(rows.begin(), rows.end()) == std::vector<std::uint32_t> { 5, 6 });
+
+    // Crosses the array limit in both directions.
+    for (std::uint32_t row = 0; row < 5000; ++row) {
+        rows.insert(2 * row);
+    }
+    REQUIRE(rows.size() == 5001);
+    for (std::uint32_t row = 0; row < 5000; row += 2) {
+        rows.erase(2 * row);
+    }
+    REQUIRE(rows.size() == 2501);
+    REQUIRE(rows.contains(6));
+    REQUIRE(!rows.contains(8));
+    REQUIRE(rows.contains(9998));
+}
+
+TEST_CASE("row_set_operations", "[index]") {
+    for (std::size_t count : { 10, 3000, 20000, 90000 }) {
+        const auto a = make_rows(1, count);
+        const auto b = make_rows(2, count / 2 + 100);
+
+        std::vector<std::uint32_t> both;
+        std::vector<std::uint32_t> either;
+        std::vector<std::uint32_t> only_a;
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(both));
+        std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(either));
+        std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(only_a));
+
+        const auto ra = to_row_set(a);
+        const auto rb = to_row_set(b);
+        REQUIRE(std::vector<std::uint32_t>(ra.begin(), ra.end()) == std::vector<std::uint32_t>(a.begin(), a.end()));
+        REQUIRE((ra & rb).to_vector() == both);
+        REQUIRE((rb & ra).to_vector() == both);
+        REQUIRE((ra | rb).to_vector() == either);
+        REQUIRE((ra - rb).to_vector() == only_a);
+        REQUIRE((ra & rb) == to_row_set(std::set<std::uint32_t>(both.begin(), both.end())));
+
+        const auto all = ra | rb;
+        REQUIRE(std::vector<std::uint32_t>(all.begin(), all.end()) == either);
+        REQUIRE((all - all).empty());
+    }
+}
+
+template<typename FlagType>
+void check_index(std::size_t count) {
+    std::vector<FlagType> values(count);
+    test_random random { 7 };
+    strong_flags::index<FlagType> idx;
+    for (auto& value : values) {
+        for (typename FlagType::bit_type bit = 0; bit < 5; ++bit) {
+            if (random.chance(static_cast<std::uint32_t>(40 + 40 * bit))) {
+                value.set(bit);
+            }
+        }
+        idx.append(value);
+    }
+
+    // Drops every seventh row and rewrites every eleventh.
+    std::vector<bool> live(count, true);
+    for (std::size_t row = 0; row < count; row += 7) {
+        REQUIRE(idx.erase(static_cast<std::uint32_t>(row)));
+        live[row] = false;
+    }
+    for (std::size_t row = 0; row < count; row += 11) {
+        values[row] = FlagType::from_bit(2);
+        idx.insert(static_cast<std::uint32_t>(row), values[row]);
+        live[row] = true;
+    }
+
+    const auto all = FlagType::from_bit(0) | FlagType::from_bit(3);
+    const auto none = FlagType::from_bit(1);
+    std::vector<std::uint32_t> expected_where;
+    std::vector<std::uint32_t> expected_any;
+    std::vector<std::uint32_t> expected_none;
+    std::vector<std::uint32_t> expected_expression;
+    std::size_t expected_size = 0;
+    for (std::size_t row = 0; row < count; ++row) {
+        if (!live[row]) {
+            continue;
+        }
+        ++expected_size;
+        const auto id = static_cast<std::uint32_t>(row);
+        if (values[row].test_all(all) && !values[row].test_any(none)) {
+            expected_where.push_back(id);
+        }
+        if (values[row].test_any(all)) {
+            expected_any.push_back(id);
+        } else {
+            expected_none.push_back(id);
+        }
+        const auto has = [&values, row](std::size_t bit) {
+            return values[row].test(static_cast<typename FlagType::bit_type>(bit));
+        };
+        if ((has(0) && has(3)) || (has(2) != !has(1))) {
+            expected_expression.push_back(id);
+        }
+    }
+
+    REQUIRE(idx.size() == expected_size);
+    REQUIRE(idx.where(all, none).to_vector() == expected_where);
+    REQUIRE(idx.any_of(all).to_vector() == expected_any);
+    REQUIRE(idx.none_of(all).to_vector() == expected_none);
+    REQUIRE((idx.all_of(all) - idx.any_of(none)) == idx.where(all, none));
+    REQUIRE(idx.all_of(FlagType()) == idx.rows());
+    REQUIRE(idx.any_of(FlagType()).empty());
+
+    using strong_flags::lazy;
+    const auto b0 = FlagType::from_bit(0);
+    const auto b1 = FlagType::from_bit(1);
+    const auto b2 = FlagType::from_bit(2);
+    const auto b3 = FlagType::from_bit(3);
+    REQUIRE(idx.where((lazy(b0) & b3) | (b2 ^ ~lazy(b1))).to_vector() == expected_expression);
+    REQUIRE(idx.where(lazy(all) & ~lazy(none)) == idx.where(all, none));
+    REQUIRE(idx.where(~lazy(all)) == idx.rows() - idx.all_of(all));
+    if (count > 22) {
+        REQUIRE(idx.value(22) == values[22]);
+        REQUIRE(idx.value(21) == FlagType());
+        REQUIRE(!idx.contains(21));
+    }
+}
+
+TEST_CASE("index_queries", "[index]") {
+    for (std::size_t count : { 0, 1, 100, 70000 }) {
+        check_index<Record::type>(count);
+        check_index<RecordWide::type>(count);
+    }
+}
+
+TEST_CASE("index_flags", "[index]") {
+    strong_flags::index<Record::type> idx;
+    REQUIRE(idx.append(Record::A | Record::B) == 0);
+    REQUIRE(idx.append(Record::B) == 1);
+    idx.insert(10, Record::A | Record::C);
+    REQUIRE(idx.append(Record::C) == 11);
+
+    REQUIRE(idx.rows(Record::A_bit).to_vector() == std::vector<std::uint32_t> { 0, 10 });
+    REQUIRE(idx.where(Record::A, Record::C).to_vector() == std::vector<std::uint32_t> { 0 });
+    REQUIRE(idx.all_of(Record::A | Record::C).to_vector() == std::vector<std::uint32_t> { 10 });
+    REQUIRE(idx.none_of(~Record::C).to_vector() == std::vector<std::uint32_t> { 11 });
+
+    using strong_flags::lazy;
+    REQUIRE(idx.where((lazy(Record::A) & Record::B) | Record::C).to_vector()
+            == std::vector<std::uint32_t> { 0, 10, 11 });
+    REQUIRE(idx.where(lazy(Record::B) & ~lazy(Record::A)).to_vector() == std::vector<std::uint32_t> { 1 });
+    REQUIRE(idx.where(lazy(Record::A) ^ Record::C).to_vector() == std::vector<std::uint32_t> { 0, 11 });
+
+    idx.clear();
+    REQUIRE(idx.empty());
+    REQUIRE(idx.append(Record::D) == 0);
+}
@@ -0,0 +1,113 @@
+#include "catch2/catch.hpp"
+#include "strong_flags/mapped.hpp"
+#include "test_values.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+STRONG_FLAGS_DEFINE_FLAGS(Column, std::uint16_t, Valid, Dirty, Pinned, Locked, Evicted);
+STRONG_FLAGS_DEFINE_FLAGS(ColumnRenamed, std::uint16_t, Valid, Dirty, Pinned, Locked, Gone);
+STRONG_FLAGS_DEFINE_FLAGS(ColumnAlias, std::uint16_t, Valid, Dirty, Pinned, Locked, Evicted);
+STRONG_FLAGS_DEFINE_FLAGS(Column32, std::uint32_t, Valid, Dirty, Pinned, Locked, Evicted);
+STRONG_FLAGS_DEFINE_FLAGS(ColumnWide, strong_flags::wide, A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, Q, R, S,
+        T, U, V, W, X, Y, Z, A1, B1, C1, D1, E1, F1, G1, H1, I1, J1, K1, L1, M1, N1, O1, P1, Q1, R1, S1, T1, U1, V1,
+        W1, X1, Y1, Z1, A2, B2, C2, D2, E2, F2, G2, H2, I2, J2, K2, L2, M2, N2, O2, P2, Q2, R2, S2, T2, U2, V2);
+
+// Stands in for a mapped page: aligned like the start of a file mapping.
+struct alignas(64) image_block {
+    unsigned char bytes[64];
+};
+
+template<typename FlagType>
+std::vector<image_block> make_image(const std::vector<FlagType>& values) {
+    std::ostringstream out;
+    REQUIRE(strong_flags::write_mapped(out, values.data(), values.size()));
+    const auto bytes = out.str();
+    std::vector<image_block> image((bytes.size() + 63) / 64);
+    std::memcpy(image.data(), bytes.data(), bytes.size());
+    return image;
+}
+
+template<typename FlagType>
+void check_round_trip(std::size_t count) {
+    const auto values = random_flags<FlagType>(99, count);
+    const auto image = make_image(values);
+    const strong_flags::mapped_flag_view<FlagType> view { image.data(), image.size() * 64 };
+    REQUIRE(view.status() == strong_flags::map_status::ok);
+    REQUIRE(view.size() == count);
+    REQUIRE(std::vector<FlagType>(view.begin(), view.end()) == values);
+    REQUIRE(view.verify());
+    if (count != 0) {
+        REQUIRE(reinterpret_cast<const void*>(view.data()) == reinterpret_cast<const char*>(image.data()) + 64);
+    }
+}
+
+TEST_CASE("mapped_round_trip", "[mapped]") {
+    for (std::size_t count : { 0, 1, 1000 }) {
+        check_round_trip<Column::type>(count);
+        check_round_trip<Column32::type>(count);
+        check_round_trip<ColumnWide::type>(count);
+    }
+}
+
+TEST_CASE("mapped_rejects", "[mapped]") {
+    const auto values = random_flags<Column::type>(99, 100);
+    auto image = make_image(values);
+    const auto bytes = image.size() * 64;
+
+    REQUIRE(strong_flags::mapped_flag_view<ColumnRenamed::type>(image.data(), bytes).status()
+            == strong_flags::map_status::type_mismatch);
+    REQUIRE(strong_flags::mapped_flag_view<Column32::type>(image.data(), bytes).status()
+            == strong_flags::map_status::type_mismatch);
+    REQUIRE(strong_flags::mapped_flag_view<Column::type>(image.data(), 20).status()
+            == strong_flags::map_status::bad_header);
+    REQUIRE(strong_flags::mapped_flag_view<Column::type>(image.data(), 64 + 2 * 99).status()
+            == strong_flags::map_status::truncated);
+
+    // Same bit count and width but a different type name.
+    auto other = make_image(random_flags<ColumnAlias::type>(99, 1));
+    REQUIRE(strong_flags::mapped_flag_view<Column::type>(other.data(), other.size() * 64).status()
+            == strong_flags::map_status::type_mismatch);
+
+    std::vector<unsigned char> shifted(bytes + 1);
+    std::memcpy(shifted.data() + 1, image.data(), bytes);
+    REQUIRE(strong_flags::mapped_flag_view<Column::type>(shifted.data() + 1, bytes).status()
+            == strong_flags::map_status::misaligned);
+
+    // Bits outside of the flag type are caught by verify(), not by opening.
+    reinterpret_cast<unsigned char*>(image.data())[64 + 2 * 50 + 1] = 0x80;
+    const strong_flags::mapped_flag_view<Column::type> view { image.data(), bytes };
+    REQUIRE(view.status() == strong_flags::map_status::ok);
+    REQUIRE(!view.verify());
+
+    reinterpret_cast<unsigned char*>(image.data())[0] = 'X';
+    REQUIRE(strong_flags::mapped_flag_view<Column::type>(image.data(), bytes).status()
+            == strong_flags::map_status::bad_header);
+}
+
+#if defined(STRONG_FLAGS_HAS_MMAP)
+TEST_CASE("mapped_file", "[mapped]") {
+    const char* path = "strong_flags_mapped_test.sfmv";
+    const auto values = random_flags<ColumnWide::type>(99, 5000);
+    {
+        std::ofstream out(path, std::ios::binary);
+        REQUIRE(strong_flags::write_mapped(out, values.data(), values.size()));
+    }
+
+    strong_flags::mapped_flag_view<ColumnWide::type> view { path };
+    REQUIRE(view.status() == strong_flags::map_status::ok);
+    REQUIRE(std::vector<ColumnWide::type>(view.begin(), view.end()) == values);
+
+    auto moved = std::move(view);
+    REQUIRE(moved.size() == values.size());
+    REQUIRE(moved[4999] == values[4999]);
+    std::remove(path);
+
+    REQUIRE(strong_flags::mapped_flag_view<ColumnWide::type>("no/such/file").status()
+            == strong_flags::map_status::io_error);
+}
+#endif
@@ -0,0 +1,120 @@
+#include "catch2/catch.hpp"
+#include "strong_flags/packed_array.hpp"
+#include "strong_flags/bulk.hpp"
+#include "test_values.hpp"
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+STRONG_FLAGS_DEFINE_MINIMAL_FLAGS(Tiny, Red, Green, Blue);
+STRONG_FLAGS_DEFINE_MINIMAL_FLAGS(Thirteen, A, B, C, D, E, F, G, H, I, J, K, L, M);
+STRONG_FLAGS_DEFINE_MINIMAL_FLAGS(Full64, A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, Q, R, S, T, U, V, W, X,
+        Y, Z, A1, B1, C1, D1, E1, F1, G1, H1, I1, J1, K1, L1, M1, N1, O1, P1, Q1, R1, S1, T1, U1, V1, W1, X1, Y1, Z1,
+        A2, B2, C2, D2, E2, F2, G2, H2, I2, J2, K2, L2);
+STRONG_FLAGS_DEFINE_MINIMAL_FLAGS(Big, A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, Q, R, S, T, U, V, W, X, Y, Z,
+        A1, B1, C1, D1, E1, F1, G1, H1, I1, J1, K1, L1, M1, N1, O1, P1, Q1, R1, S1, T1, U1, V1, W1, X1, Y1, Z1, A2,
+        B2, C2, D2, E2, F2, G2, H2, I2, J2, K2, L2, M2);
+
+static_assert(std::is_same<Tiny::type::underlying_type, std::uint8_t>::value, "");
+static_assert(std::is_same<Thirteen::type::underlying_type, std::uint16_t>::value, "");
+static_assert(std::is_same<Full64::type::underlying_type, std::uint64_t>::value, "");
+static_assert(std::is_same<Big::type::underlying_type, strong_flags::wide_bitset<65>>::value, "");
+static_assert(std::is_same<strong_flags::storage_t<strong_flags::minimal, 17>, std::uint32_t>::value, "");
+
+template<typename FlagType>
+std::vector<FlagType> packed_values(std::size_t count) {
+    std::vector<FlagType> values(count);
+    test_random random { 31337 };
+    for (auto& value : values) {
+        value = FlagType::from_underlying_type(static_cast<typename FlagType::underlying_type>(random.next64()));
+    }
+    return values;
+}
+
+template<typename FlagType>
+void check_packed(std::size_t count) {
+    const auto values = packed_values<FlagType>(count);
+    strong_flags::packed_flag_array<FlagType> packed(values.data(), values.size());
+    REQUIRE(packed.size() == count);
+    REQUIRE(packed.word_count() == (count * FlagType::bit_count + 63) / 64 + 1);
+    REQUIRE(packed.to_vector() == values);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        REQUIRE(packed.get(i) == values[i]);
+    }
+
+    // Batch access from an unaligned start.
+    if (count > 10) {
+        std::vector<FlagType> part(count - 7);
+        packed.get(7, part.data(), part.size());
+        REQUIRE(std::equal(part.begin(), part.end(), values.begin() + 7));
+
+        std::vector<FlagType> reversed(values.rbegin(), values.rend());
+        packed.set(3, reversed.data(), count - 3);
+        for (std::size_t i = 0; i < 3; ++i) {
+            REQUIRE(packed[i] == values[i]);
+        }
+        for (std::size_t i = 3; i < count; ++i) {
+            REQUIRE(packed[i] == reversed[i - 3]);
+        }
+    }
+
+    strong_flags::packed_flag_array<FlagType> pushed;
+    for (const auto& value : values) {
+        pushed.push_back(value);
+    }
+    REQUIRE(pushed == strong_flags::packed_flag_array<FlagType>(values.data(), values.size()));
+}
+
+TEST_CASE("packed_round_trip", "[packed]") {
+    for (std::size_t count : { 0, 1, 21, 22, 64, 1000 }) {
+        check_packed<Tiny::type>(count);
+        check_packed<Thirteen::type>(count);
+        check_packed<Full64::type>(count);
+    }
+}
+
+TEST_CASE("packed_reference", "[packed]") {
+    strong_flags::packed_flag_array<Tiny::type> packed(100, Tiny::Green);
+    REQUIRE(packed.word_count() == 6);
+    REQUIRE(packed[99] == Tiny::Green);
+
+    packed[21] = Tiny::Red;
+    packed[21] |= Tiny::Blue;
+    REQUIRE(packed[21] == (Tiny::Red | Tiny::Blue));
+    REQUIRE(packed[21].test(Tiny::Blue_bit) == true);
+    packed[21] &= Tiny::Blue;
+    packed[22] ^= Tiny::Green | Tiny::Red;
+    packed[20] = packed[21];
+    REQUIRE(packed[20] == Tiny::Blue);
+    REQUIRE(packed[21] == Tiny::Blue);
+    REQUIRE(packed[22] == Tiny::Red);
+    REQUIRE(packed[23] == Tiny::Green);
+
+    std::size_t green = 0;
+    for (Tiny::type value : static_cast<const strong_flags::packed_flag_array<Tiny::type>&>(packed)) {
+        green += value.test(Tiny::Green_bit) ? 1 : 0;
+    }
+    REQUIRE(green == 97);
+    for (auto ref : packed) {
+        ref = Tiny::Blue;
+    }
+    const auto unpacked = packed.to_vector();
+    REQUIRE(strong_flags::bulk::count_all(unpacked.data(), unpacked.size(), Tiny::type(Tiny::Blue)) == 100);
+}
+
+TEST_CASE("packed_resize", "[packed]") {
+    strong_flags::packed_flag_array<Thirteen::type> packed(50, Thirteen::A | Thirteen::M);
+    packed.resize(7);
+    REQUIRE(packed.size() == 7);
+    REQUIRE(packed[6] == (Thirteen::A | Thirteen::M));
+    packed.resize(60);
+    REQUIRE(packed[6] == (Thirteen::A | Thirteen::M));
+    REQUIRE(packed[7] == Thirteen::type());
+    REQUIRE(packed[59] == Thirteen::type());
+
+    packed.clear();
+    REQUIRE(packed.empty() == true);
+    packed.push_back(Thirteen::C);
+    REQUIRE(packed[0] == Thirteen::C);
+}
@@ -0,0 +1,104 @@
+#include "catch2/catch.hpp"
+#include "strong_flags/remap.hpp"
+#include <cstdint>
+#include <vector>
+
+STRONG_FLAGS_DEFINE_FLAGS(Internal, std::uint8_t, Ack, Syn, Fin, Rst, Urg, Psh);
+STRONG_FLAGS_DEFINE_FLAGS(Wire, std::uint16_t, Pad0, Fin, Syn, Rst, Psh, Ack, Urg, Pad7, Pad8, Ece, Cwr);
+STRONG_FLAGS_DEFINE_FLAGS(Wire64, std::uint64_t, A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, Q, R, S, T, U, V,
+        W, X, Y, Z, A1, B1, C1, D1, E1, F1, G1, H1, I1, J1, K1, L1, M1, N1, O1, P1, Q1, R1, S1, T1, U1, V1, W1, X1,
+        Y1, Z1, A2, B2, C2, D2, E2, F2, G2, H2, I2, J2, K2, L2);
+STRONG_FLAGS_DEFINE_FLAGS(WireWide, strong_flags::wide, A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, Q, R, S, T,
+        U, V, W, X, Y, Z, A1, B1, C1, D1, E1, F1, G1, H1, I1, J1, K1, L1, M1, N1, O1, P1, Q1, R1, S1, T1, U1, V1, W1,
+        X1, Y1, Z1, A2, B2, C2, D2, E2, F2, G2, H2, I2, J2, K2, L2, M2, N2, O2, P2, Q2, R2, S2, T2, U2, V2, W2, X2);
+
+using strong_flags::map_bit;
+
+// Bits move by different distances and cross each other.
+constexpr auto s_to_wire = strong_flags::remap<Internal::type, Wire::type>(
+        map_bit<Internal::Ack_bit, Wire::Ack_bit>,
+        map_bit<Internal::Syn_bit, Wire::Syn_bit>,
+        map_bit<Internal::Fin_bit, Wire::Fin_bit>,
+        map_bit<Internal::Rst_bit, Wire::Rst_bit>,
+        map_bit<Internal::Urg_bit, Wire::Urg_bit>,
+        map_bit<Internal::Psh_bit, Wire::Psh_bit>);
+
+// Order preserving, with a single distance for most bits.
+constexpr auto s_spread = strong_flags::remap<Internal::type, Wire64::type>(
+        map_bit<Internal::Ack_bit, Wire64::C_bit>,
+        map_bit<Internal::Syn_bit, Wire64::D_bit>,
+        map_bit<Internal::Fin_bit, Wire64::E_bit>,
+        map_bit<Internal::Psh_bit, Wire64::L2_bit>);
+
+constexpr auto s_shift = strong_flags::remap<Internal::type, Wire::type>(
+        map_bit<Internal::Ack_bit, Wire::Syn_bit>,
+        map_bit<Internal::Fin_bit, Wire::Psh_bit>);
+
+constexpr auto s_from_wide = strong_flags::remap<WireWide::type, Internal::type>(
+        map_bit<WireWide::X2_bit, Internal::Ack_bit>,
+        map_bit<WireWide::A_bit, Internal::Fin_bit>,
+        map_bit<WireWide::L1_bit, Internal::Fin_bit>);
+
+static_assert(s_to_wire(Internal::Ack | Internal::Psh) == (Wire::Ack | Wire::Psh), "");
+static_assert(s_to_wire(Internal::type()) == Wire::type(), "");
+static_assert(s_spread(Internal::Ack | Internal::Psh) == (Wire64::C | Wire64::L2), "");
+static_assert(s_shift(Internal::Ack | Internal::Syn) == Wire::Syn, "");
+static_assert(decltype(s_shift)::strategy == strong_flags::remap_strategy::shift, "");
+static_assert(decltype(s_from_wide)::strategy == strong_flags::remap_strategy::bits, "");
+static_assert(decltype(s_to_wire)::strategy == strong_flags::remap_strategy::table, "");
+#if defined(STRONG_FLAGS_REMAP_BMI2)
+static_assert(decltype(s_spread)::strategy == strong_flags::remap_strategy::bmi2, "");
+#else
+static_assert(decltype(s_spread)::strategy == strong_flags::remap_strategy::shift, "");
+#endif
+
+// The chain of tests the remappers replace.
+template<typename From, typename To>
+To remap_slowly(const From& value, const std::vector<std::pair<std::size_t, std::size_t>>& mapping) {
+    To res;
+    for (const auto& [from, to] : mapping) {
+        if (value.test(from)) {
+            res.set(to);
+        }
+    }
+    return res;
+}
+
+TEST_CASE("remap_all_values", "[remap]") {
+    const std::vector<std::pair<std::size_t, std::size_t>> to_wire { { 0, 5 }, { 1, 2 }, { 2, 1 }, { 3, 3 },
+        { 4, 6 }, { 5, 4 } };
+    const std::vector<std::pair<std::size_t, std::size_t>> spread { { 0, 2 }, { 1, 3 }, { 2, 4 }, { 5, 63 } };
+    const std::vector<std::pair<std::size_t, std::size_t>> shift { { 0, 2 }, { 2, 4 } };
+
+    std::vector<Internal::type> values;
+    for (unsigned v = 0; v < 64; ++v) {
+        values.push_back(Internal::from_underlying_type(static_cast<std::uint8_t>(v)));
+    }
+    for (const auto& value : values) {
+        REQUIRE(s_to_wire(value) == remap_slowly<Internal::type, Wire::type>(value, to_wire));
+        REQUIRE(s_spread(value) == remap_slowly<Internal::type, Wire64::type>(value, spread));
+        REQUIRE(s_shift(value) == remap_slowly<Internal::type, Wire::type>(value, shift));
+    }
+
+    std::vector<Wire::type> out(values.size());
+    s_to_wire.apply(values.data(), values.size(), out.data());
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        REQUIRE(out[i] == s_to_wire(values[i]));
+    }
+}
+
+TEST_CASE("remap_wide", "[remap]") {
+    REQUIRE(s_from_wide(WireWide::X2 | WireWide::B) == Internal::Ack);
+    REQUIRE(s_from_wide(WireWide::A | WireWide::L1) == Internal::Fin);
+    REQUIRE(s_from_wide(WireWide::L1 | WireWide::X2) == (Internal::Fin | Internal::Ack));
+
+    const auto to_wide = strong_flags::remap<Internal::type, WireWide::type>(
+            map_bit<Internal::Ack_bit, WireWide::X2_bit>,
+            map_bit<Internal::Syn_bit, WireWide::A_bit>);
+    const Internal::type values[] = { Internal::Ack, Internal::Syn | Internal::Fin, Internal::type() };
+    WireWide::type out[3];
+    to_wide.apply(values, 3, out);
+    REQUIRE(out[0] == WireWide::X2);
+    REQUIRE(out[1] == WireWide::A);
+    REQUIRE(out[2] == WireWide::type());
+}
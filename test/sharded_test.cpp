@@ -0,0 +1,54 @@
+#include "catch2/catch.hpp"
+#include "strong_flags/sharded.hpp"
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+STRONG_FLAGS_DEFINE_FLAGS(Health, std::uint32_t, SeenError, Degraded, Throttled, Restarted);
+
+TEST_CASE("sharded_set_snapshot", "[sharded]") {
+    strong_flags::sharded_flags<Health::type> flags { 3 };
+    REQUIRE(flags.shard_count() == 4);
+    REQUIRE(flags.snapshot() == Health::type());
+
+    flags.set(Health::SeenError_bit);
+    flags.set(Health::Degraded | Health::Throttled, std::memory_order_release);
+    REQUIRE(flags.snapshot(std::memory_order_acquire) == (Health::SeenError | Health::Degraded | Health::Throttled));
+    REQUIRE(flags.test(Health::Degraded_bit));
+    REQUIRE(flags.test_any(Health::Restarted | Health::SeenError));
+    REQUIRE(!flags.test_all(Health::Restarted | Health::SeenError));
+
+    flags.clear(Health::Throttled);
+    REQUIRE(flags.snapshot() == (Health::SeenError | Health::Degraded));
+
+    REQUIRE(flags.clear_and_collect() == (Health::SeenError | Health::Degraded));
+    REQUIRE(flags.snapshot() == Health::type());
+    REQUIRE(flags.clear_and_collect() == Health::type());
+
+    REQUIRE(strong_flags::sharded_flags<Health::type>().shard_count() >= 1);
+}
+
+TEST_CASE("sharded_concurrent", "[sharded]") {
+    strong_flags::sharded_flags<Health::type> flags { 2 };
+    std::vector<std::thread> threads;
+    for (Health::type::bit_type bit = 0; bit < 4; ++bit) {
+        threads.emplace_back([&flags, bit] {
+            for (int i = 0; i < 1000; ++i) {
+                flags.set(bit, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    // Collected sets plus whatever is left must add up to every raised flag.
+    Health::type collected;
+    for (int i = 0; i < 100; ++i) {
+        collected |= flags.clear_and_collect();
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    collected |= flags.clear_and_collect();
+
+    REQUIRE(collected == (Health::SeenError | Health::Degraded | Health::Throttled | Health::Restarted));
+    REQUIRE(flags.snapshot() == Health::type());
+}
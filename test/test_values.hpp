@@ -0,0 +1,50 @@
+#ifndef TEST_TEST_VALUES_H_
+#define TEST_TEST_VALUES_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Seeded pseudo random numbers for the tests, so every run sees the same data.
+class test_random {
+public:
+    explicit test_random(std::uint64_t seed) noexcept : m_state { seed } {
+    }
+
+    // 32 random bits, taken from the high half of a 64-bit linear congruential generator.
+    std::uint32_t next() noexcept {
+        m_state = m_state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<std::uint32_t>(m_state >> 32);
+    }
+
+    std::uint64_t next64() noexcept {
+        const std::uint64_t high = next();
+        return (high << 32) | next();
+    }
+
+    // True with probability numerator / 256.
+    bool chance(std::uint32_t numerator) noexcept {
+        return (next() >> 24) < numerator;
+    }
+
+private:
+    std::uint64_t m_state;
+};
+
+// `count` values in which each of the lowest `bits` flags is set with probability numerator / 256.
+template<typename FlagType>
+std::vector<FlagType> random_flags(std::uint64_t seed, std::size_t count, std::uint32_t numerator = 128,
+        std::size_t bits = FlagType::bit_count) {
+    test_random random { seed };
+    std::vector<FlagType> values(count);
+    for (auto& value : values) {
+        for (typename FlagType::bit_type bit = 0; bit < bits; ++bit) {
+            if (random.chance(numerator)) {
+                value.set(bit);
+            }
+        }
+    }
+    return values;
+}
+
+#endif /* TEST_TEST_VALUES_H_ */
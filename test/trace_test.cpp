@@ -0,0 +1,122 @@
+#include "catch2/catch.hpp"
+#include "strong_flags/trace.hpp"
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+STRONG_FLAGS_DEFINE_FLAGS(Link, std::uint16_t, Up, Carrier, Duplex, Error);
+STRONG_FLAGS_DEFINE_FLAGS(Quiet, std::uint16_t, Up, Carrier);
+
+STRONG_FLAGS_TRACE_FLAGS(Link::type);
+
+static_assert(strong_flags::traced<Link::type>::value, "");
+static_assert(!strong_flags::traced<Quiet::type>::value, "");
+static_assert(std::is_empty<strong_flags::detail::trace_guard<Quiet::type, std::uint16_t>>::value, "");
+
+template<typename FlagType>
+std::vector<strong_flags::trace::record> records_of() {
+    std::vector<strong_flags::trace::record> res;
+    for (const auto& rec : strong_flags::trace::snapshot()) {
+        if (rec.is<FlagType>()) {
+            res.push_back(rec);
+        }
+    }
+    return res;
+}
+
+TEST_CASE("trace_mutators", "[trace]") {
+    const auto before = records_of<Link::type>().size();
+
+    Link::type link;
+    link.set(Link::Up_bit);
+    link.set(Link::Carrier);
+    link.toggle(Link::Duplex_bit);
+    link.clear(Link::Up_bit);
+    link ^= Link::Error;
+    link &= Link::Error;
+    link |= Link::Up;
+    link = link | Link::Carrier;  // not a mutator
+
+    Quiet::type quiet;
+    quiet.set(Quiet::Up_bit);
+
+    const auto records = records_of<Link::type>();
+    REQUIRE(records.size() == before + 7);
+    REQUIRE(records_of<Quiet::type>().empty());
+
+    const std::vector<std::pair<Link::type, Link::type>> expected {
+        { Link::type(), Link::Up },
+        { Link::Up, Link::Up | Link::Carrier },
+        { Link::Up | Link::Carrier, Link::Up | Link::Carrier | Link::Duplex },
+        { Link::Up | Link::Carrier | Link::Duplex, Link::Carrier | Link::Duplex },
+        { Link::Carrier | Link::Duplex, Link::Carrier | Link::Duplex | Link::Error },
+        { Link::Carrier | Link::Duplex | Link::Error, Link::Error },
+        { Link::Error, Link::Error | Link::Up },
+    };
+    const auto thread = std::hash<std::thread::id> { }(std::this_thread::get_id());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        const auto& rec = records[before + i];
+        REQUIRE(rec.old_flags<Link::type>() == expected[i].first);
+        REQUIRE(rec.new_flags<Link::type>() == expected[i].second);
+        REQUIRE(rec.thread == thread);
+        REQUIRE(rec.site != nullptr);
+        REQUIRE((i == 0 || rec.timestamp >= records[before + i - 1].timestamp));
+    }
+
+    char line[128];
+    const auto length = strong_flags::trace::format_record(line, sizeof(line), records[before + 3]);
+    const std::string text { line };
+    REQUIRE(text.size() == length);
+    REQUIRE(text.find(" Link::type: Up|Carrier|Duplex -> Carrier|Duplex") != std::string::npos);
+
+    char small[8];
+    REQUIRE(strong_flags::trace::format_record(small, sizeof(small), records[before + 3]) == length);
+    REQUIRE(std::string(small) == text.substr(0, 7));
+}
+
+TEST_CASE("trace_site", "[trace]") {
+    // Each call site records its own address, also when nothing is inlined by the optimizer.
+    Link::type link;
+    link.set(Link::Up_bit);
+    link ^= Link::Carrier;
+    link.clear(Link::Up);
+    const auto records = records_of<Link::type>();
+    REQUIRE(records.size() >= 3);
+    const auto* last = &records[records.size() - 3];
+    REQUIRE(last[0].site != last[1].site);
+    REQUIRE(last[1].site != last[2].site);
+    REQUIRE(last[0].site != last[2].site);
+}
+
+TEST_CASE("trace_threads", "[trace]") {
+    // More records than a buffer holds: every thread keeps exactly its latest `capacity` records.
+    constexpr std::size_t per_thread = strong_flags::detail::trace_capacity + 100;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([] {
+            Link::type link;
+            for (std::size_t i = 0; i < per_thread; ++i) {
+                link.toggle(Link::Error_bit);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    std::size_t toggles = 0;
+    for (const auto& rec : records_of<Link::type>()) {
+        if ((rec.old_value ^ rec.new_value) == Link::Error.to_underlying_type()) {
+            ++toggles;
+        }
+    }
+    // Finished threads hand their buffers on, so later threads may overwrite earlier ones.
+    REQUIRE(toggles >= strong_flags::detail::trace_capacity);
+    REQUIRE(toggles <= 4 * strong_flags::detail::trace_capacity);
+
+    std::FILE* out = std::tmpfile();
+    strong_flags::trace::dump(out);
+    REQUIRE(std::ftell(out) > 0);
+    std::fclose(out);
+}
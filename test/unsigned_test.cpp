@@ -1,6 +1,7 @@
 #include "catch2/catch.hpp"
 #include "strong_flags/strong_flags.hpp"
 #include <type_traits>
+#include <vector>
 
 STRONG_FLAGS_DEFINE_FLAGS(Type1, unsigned int, Flag0, Flag1, Flag2);
 
@@ -112,3 +113,48 @@ TEST_CASE("constexpr", "[int-based]") {
 
 
 
+TEST_CASE("bit_queries", "[int-based]") {
+    const Type1::type empty;
+    const auto t1 = Type1::Flag0 | Type1::Flag2;
+
+    REQUIRE(empty.empty() == true);
+    REQUIRE(empty.any() == false);
+    REQUIRE(empty.count() == 0);
+    REQUIRE(empty.lowest_bit() == 3);
+    REQUIRE(empty.highest_bit() == 3);
+
+    REQUIRE(t1.empty() == false);
+    REQUIRE(t1.any() == true);
+    REQUIRE(t1.count() == 2);
+    REQUIRE(t1.lowest_bit() == Type1::Flag0_bit);
+    REQUIRE(t1.highest_bit() == Type1::Flag2_bit);
+    REQUIRE(Type1::Flag1.highest_bit() == Type1::Flag1_bit);
+}
+
+TEST_CASE("bit_iteration", "[int-based]") {
+    const auto t1 = Type1::Flag0 | Type1::Flag2;
+
+    std::vector<Type1::type::bit_type> bits;
+    for (auto bit : t1.bits()) {
+        bits.push_back(bit);
+    }
+    REQUIRE(bits == std::vector<Type1::type::bit_type> { Type1::Flag0_bit, Type1::Flag2_bit });
+
+    std::vector<Type1::type> flags;
+    for (auto flag : (t1 | Type1::Flag1).flags()) {
+        flags.push_back(flag);
+    }
+    REQUIRE(flags == std::vector<Type1::type> { Type1::Flag0, Type1::Flag1, Type1::Flag2 });
+
+    REQUIRE(Type1::type().bits().begin() == Type1::type().bits().end());
+}
+
+TEST_CASE("bit_queries_constexpr", "[int-based]") {
+    constexpr auto t1 = Type1::Flag1 | Type1::Flag2;
+
+    static_assert(t1.count() == 2, "");
+    static_assert(t1.lowest_bit() == Type1::Flag1_bit, "");
+    static_assert(t1.highest_bit() == Type1::Flag2_bit, "");
+    static_assert(*t1.bits().begin() == Type1::Flag1_bit, "");
+    static_assert(*++t1.flags().begin() == Type1::Flag2, "");
+}
@@ -0,0 +1,282 @@
+#include "catch2/catch.hpp"
+#include "strong_flags/strong_flags.hpp"
+#include <type_traits>
+#include <vector>
+
+STRONG_FLAGS_DEFINE_FLAGS(Wide1, strong_flags::wide, Flag0, Flag1, Flag2, Flag3, Flag4, Flag5, Flag6, Flag7, Flag8,
+        Flag9, Flag10, Flag11, Flag12, Flag13, Flag14, Flag15, Flag16, Flag17, Flag18, Flag19, Flag20, Flag21,
+        Flag22, Flag23, Flag24, Flag25, Flag26, Flag27, Flag28, Flag29, Flag30, Flag31, Flag32, Flag33, Flag34,
+        Flag35, Flag36, Flag37, Flag38, Flag39, Flag40, Flag41, Flag42, Flag43, Flag44, Flag45, Flag46, Flag47,
+        Flag48, Flag49, Flag50, Flag51, Flag52, Flag53, Flag54, Flag55, Flag56, Flag57, Flag58, Flag59, Flag60,
+        Flag61, Flag62, Flag63, Flag64, Flag65, Flag66, Flag67, Flag68, Flag69, Flag70, Flag71, Flag72, Flag73,
+        Flag74, Flag75, Flag76, Flag77, Flag78, Flag79, Flag80, Flag81, Flag82, Flag83, Flag84, Flag85, Flag86,
+        Flag87, Flag88, Flag89, Flag90, Flag91, Flag92, Flag93, Flag94, Flag95, Flag96, Flag97, Flag98, Flag99,
+        Flag100, Flag101, Flag102, Flag103, Flag104, Flag105, Flag106, Flag107, Flag108, Flag109, Flag110, Flag111,
+        Flag112, Flag113, Flag114, Flag115, Flag116, Flag117, Flag118, Flag119, Flag120, Flag121, Flag122, Flag123,
+        Flag124, Flag125, Flag126, Flag127, Flag128, Flag129);
+
+STRONG_FLAGS_DEFINE_FLAGS(Wide520, strong_flags::wide, Flag0, Flag1, Flag2, Flag3, Flag4, Flag5, Flag6, Flag7,
+        Flag8, Flag9, Flag10, Flag11, Flag12, Flag13, Flag14, Flag15, Flag16, Flag17, Flag18, Flag19, Flag20,
+        Flag21, Flag22, Flag23, Flag24, Flag25, Flag26, Flag27, Flag28, Flag29, Flag30, Flag31, Flag32, Flag33,
+        Flag34, Flag35, Flag36, Flag37, Flag38, Flag39, Flag40, Flag41, Flag42, Flag43, Flag44, Flag45, Flag46,
+        Flag47, Flag48, Flag49, Flag50, Flag51, Flag52, Flag53, Flag54, Flag55, Flag56, Flag57, Flag58, Flag59,
+        Flag60, Flag61, Flag62, Flag63, Flag64, Flag65, Flag66, Flag67, Flag68, Flag69, Flag70, Flag71, Flag72,
+        Flag73, Flag74, Flag75, Flag76, Flag77, Flag78, Flag79, Flag80, Flag81, Flag82, Flag83, Flag84, Flag85,
+        Flag86, Flag87, Flag88, Flag89, Flag90, Flag91, Flag92, Flag93, Flag94, Flag95, Flag96, Flag97, Flag98,
+        Flag99, Flag100, Flag101, Flag102, Flag103, Flag104, Flag105, Flag106, Flag107, Flag108, Flag109, Flag110,
+        Flag111, Flag112, Flag113, Flag114, Flag115, Flag116, Flag117, Flag118, Flag119, Flag120, Flag121, Flag122,
+        Flag123, Flag124, Flag125, Flag126, Flag127, Flag128, Flag129, Flag130, Flag131, Flag132, Flag133, Flag134,
+        Flag135, Flag136, Flag137, Flag138, Flag139, Flag140, Flag141, Flag142, Flag143, Flag144, Flag145, Flag146,
+        Flag147, Flag148, Flag149, Flag150, Flag151, Flag152, Flag153, Flag154, Flag155, Flag156, Flag157, Flag158,
+        Flag159, Flag160, Flag161, Flag162, Flag163, Flag164, Flag165, Flag166, Flag167, Flag168, Flag169, Flag170,
+        Flag171, Flag172, Flag173, Flag174, Flag175, Flag176, Flag177, Flag178, Flag179, Flag180, Flag181, Flag182,
+        Flag183, Flag184, Flag185, Flag186, Flag187, Flag188, Flag189, Flag190, Flag191, Flag192, Flag193, Flag194,
+        Flag195, Flag196, Flag197, Flag198, Flag199, Flag200, Flag201, Flag202, Flag203, Flag204, Flag205, Flag206,
+        Flag207, Flag208, Flag209, Flag210, Flag211, Flag212, Flag213, Flag214, Flag215, Flag216, Flag217, Flag218,
+        Flag219, Flag220, Flag221, Flag222, Flag223, Flag224, Flag225, Flag226, Flag227, Flag228, Flag229, Flag230,
+        Flag231, Flag232, Flag233, Flag234, Flag235, Flag236, Flag237, Flag238, Flag239, Flag240, Flag241, Flag242,
+        Flag243, Flag244, Flag245, Flag246, Flag247, Flag248, Flag249, Flag250, Flag251, Flag252, Flag253, Flag254,
+        Flag255, Flag256, Flag257, Flag258, Flag259, Flag260, Flag261, Flag262, Flag263, Flag264, Flag265, Flag266,
+        Flag267, Flag268, Flag269, Flag270, Flag271, Flag272, Flag273, Flag274, Flag275, Flag276, Flag277, Flag278,
+        Flag279, Flag280, Flag281, Flag282, Flag283, Flag284, Flag285, Flag286, Flag287, Flag288, Flag289, Flag290,
+        Flag291, Flag292, Flag293, Flag294, Flag295, Flag296, Flag297, Flag298, Flag299, Flag300, Flag301, Flag302,
+        Flag303, Flag304, Flag305, Flag306, Flag307, Flag308, Flag309, Flag310, Flag311, Flag312, Flag313, Flag314,
+        Flag315, Flag316, Flag317, Flag318, Flag319, Flag320, Flag321, Flag322, Flag323, Flag324, Flag325, Flag326,
+        Flag327, Flag328, Flag329, Flag330, Flag331, Flag332, Flag333, Flag334, Flag335, Flag336, Flag337, Flag338,
+        Flag339, Flag340, Flag341, Flag342, Flag343, Flag344, Flag345, Flag346, Flag347, Flag348, Flag349, Flag350,
+        Flag351, Flag352, Flag353, Flag354, Flag355, Flag356, Flag357, Flag358, Flag359, Flag360, Flag361, Flag362,
+        Flag363, Flag364, Flag365, Flag366, Flag367, Flag368, Flag369, Flag370, Flag371, Flag372, Flag373, Flag374,
+        Flag375, Flag376, Flag377, Flag378, Flag379, Flag380, Flag381, Flag382, Flag383, Flag384, Flag385, Flag386,
+        Flag387, Flag388, Flag389, Flag390, Flag391, Flag392, Flag393, Flag394, Flag395, Flag396, Flag397, Flag398,
+        Flag399, Flag400, Flag401, Flag402, Flag403, Flag404, Flag405, Flag406, Flag407, Flag408, Flag409, Flag410,
+        Flag411, Flag412, Flag413, Flag414, Flag415, Flag416, Flag417, Flag418, Flag419, Flag420, Flag421, Flag422,
+        Flag423, Flag424, Flag425, Flag426, Flag427, Flag428, Flag429, Flag430, Flag431, Flag432, Flag433, Flag434,
+        Flag435, Flag436, Flag437, Flag438, Flag439, Flag440, Flag441, Flag442, Flag443, Flag444, Flag445, Flag446,
+        Flag447, Flag448, Flag449, Flag450, Flag451, Flag452, Flag453, Flag454, Flag455, Flag456, Flag457, Flag458,
+        Flag459, Flag460, Flag461, Flag462, Flag463, Flag464, Flag465, Flag466, Flag467, Flag468, Flag469, Flag470,
+        Flag471, Flag472, Flag473, Flag474, Flag475, Flag476, Flag477, Flag478, Flag479, Flag480, Flag481, Flag482,
+        Flag483, Flag484, Flag485, Flag486, Flag487, Flag488, Flag489, Flag490, Flag491, Flag492, Flag493, Flag494,
+        Flag495, Flag496, Flag497, Flag498, Flag499, Flag500, Flag501, Flag502, Flag503, Flag504, Flag505, Flag506,
+        Flag507, Flag508, Flag509, Flag510, Flag511, Flag512, Flag513, Flag514, Flag515, Flag516, Flag517, Flag518,
+        Flag519);
+
+// Assembled by hand from the helpers older code used.
+namespace Assembled {
+class type : public strong_flags::impl<type, strong_flags::wide_bitset<130>, 130> {
+public:
+    using impl::impl;
+};
+
+STRONG_FLAGS_MAKE_FLAGS(STRONG_FLAGS_ARG_COUNT(Low0, Low1, Low2), Low0, Low1, Low2);
+STRONG_FLAGS_MAKE_FLAG(High, 129);
+}
+
+TEST_CASE("wide_single_flag", "[wide]") {
+    auto t1 = Wide1::Flag0;
+
+    REQUIRE(t1.test_any(Wide1::Flag0) == true);
+    REQUIRE(t1.test_all(Wide1::Flag0) == true);
+
+    REQUIRE(t1.test_any(Wide1::Flag1) == false);
+    REQUIRE(t1.test_any(Wide1::Flag129) == false);
+
+    REQUIRE(t1.to_underlying_type().word(0) == 0x1U);
+    REQUIRE(t1.to_underlying_type().word(2) == 0x0U);
+
+    REQUIRE(t1 == Wide1::Flag0);
+
+    REQUIRE(t1.test(Wide1::Flag0_bit) == true);
+    REQUIRE(t1.test(Wide1::Flag129_bit) == false);
+    REQUIRE(Wide1::Flag129.test(Wide1::Flag129_bit) == true);
+    REQUIRE(Wide1::Flag129.test(130) == false);
+
+    const auto t2(t1);
+
+    REQUIRE(t2 == t1);
+    REQUIRE(Wide1::Flag0 != Wide1::Flag129);
+    REQUIRE(Wide1::Flag64 != Wide1::Flag0);
+}
+
+TEST_CASE("wide_Multiple_flags", "[wide]") {
+    auto t1 = Wide1::Flag0 | Wide1::Flag70 | Wide1::Flag129;
+
+    REQUIRE(t1.test_any(Wide1::Flag0) == true);
+    REQUIRE(t1.test_any(Wide1::Flag1) == false);
+    REQUIRE(t1.test_any(Wide1::Flag70) == true);
+    REQUIRE(t1.test_any(Wide1::Flag129) == true);
+
+    REQUIRE(t1.test_all(Wide1::Flag0 | Wide1::Flag1) == false);
+    REQUIRE(t1.test_all(Wide1::Flag0 | Wide1::Flag129) == true);
+    REQUIRE(t1.test_all(Wide1::Flag70 | Wide1::Flag128) == false);
+
+    Wide1::type t2;
+    REQUIRE(t2.test_any(~t2) == false);
+
+    t2 = t1;
+    REQUIRE(t2 == t1);
+    REQUIRE(t2.to_underlying_type().word(0) == 0x1U);
+    REQUIRE(t2.to_underlying_type().word(1) == (0x1U << 6));
+    REQUIRE(t2.to_underlying_type().word(2) == 0x2U);
+}
+
+TEST_CASE("wide_Mutators_single", "[wide]") {
+    auto t1 = Wide1::from_bit(Wide1::Flag100_bit);
+
+    t1.set(Wide1::Flag100_bit);
+    REQUIRE(t1 == Wide1::Flag100);
+    t1.set(Wide1::Flag0_bit);
+    REQUIRE(t1 == (Wide1::Flag0 | Wide1::Flag100));
+
+    t1.clear(Wide1::Flag2_bit);
+    REQUIRE(t1 == (Wide1::Flag0 | Wide1::Flag100));
+    t1.clear(Wide1::Flag100_bit);
+    REQUIRE(t1 == Wide1::Flag0);
+
+    t1.toggle(Wide1::Flag129_bit);
+    REQUIRE(t1 == (Wide1::Flag0 | Wide1::Flag129));
+    t1.toggle(Wide1::Flag0_bit);
+    REQUIRE(t1 == Wide1::Flag129);
+
+    t1.set(130);
+    t1.toggle(200);
+    REQUIRE(t1 == Wide1::Flag129);
+}
+
+TEST_CASE("wide_Mutators_multiple", "[wide]") {
+    auto t1 = Wide1::Flag65;
+    auto t2(t1);
+
+    t1.set(Wide1::Flag0 | Wide1::Flag65);
+    t2 |= Wide1::Flag0 | Wide1::Flag65;
+    REQUIRE(t1 == t2);
+    REQUIRE(t1 == (Wide1::Flag0 | Wide1::Flag65));
+
+    t1.clear(Wide1::Flag65 | Wide1::Flag128);
+    t2 &= ~(Wide1::Flag65 | Wide1::Flag128);
+
+    REQUIRE(t1 == t2);
+    REQUIRE(t1 == Wide1::Flag0);
+
+    t1.toggle(Wide1::Flag0 | Wide1::Flag128);
+    t2 ^= Wide1::Flag0 | Wide1::Flag128;
+
+    REQUIRE(t1 == t2);
+    REQUIRE(t1 == Wide1::Flag128);
+}
+
+TEST_CASE("wide_complement_masks_padding", "[wide]") {
+    const auto all = ~Wide1::type();
+
+    REQUIRE(all.test(Wide1::Flag129_bit) == true);
+    REQUIRE(all.to_underlying_type().word(1) == ~0ULL);
+    REQUIRE(all.to_underlying_type().word(2) == 0x3U);
+    REQUIRE(all.to_underlying_type().word(3) == 0x0U);
+    REQUIRE((~all) == Wide1::type());
+
+    Wide1::type::underlying_type raw;
+    for (std::size_t i = 0; i < raw.word_count; ++i) {
+        raw.word(i) = ~0ULL;
+    }
+    REQUIRE(Wide1::from_underlying_type(raw) == all);
+}
+
+TEST_CASE("wide_type_traits", "[wide]") {
+    REQUIRE(std::is_trivially_copyable<Wide1::type>::value == true);
+    REQUIRE(std::is_standard_layout<Wide1::type>::value == true);
+    REQUIRE(sizeof(Wide1::type) == sizeof(Wide1::type::underlying_type));
+    REQUIRE(alignof(Wide1::type) == 32);
+}
+
+TEST_CASE("wide_constexpr", "[wide]") {
+    constexpr Wide1::type empty;
+    constexpr auto t1 = Wide1::Flag0;
+    constexpr auto t2 = Wide1::from_underlying_type(Wide1::Flag0.to_underlying_type());
+    constexpr auto t3 = Wide1::from_bit(100);
+
+    constexpr auto n1 = t1.to_underlying_type();
+    constexpr auto n2 = static_cast<Wide1::type::underlying_type>(t2);
+
+    constexpr bool b1 = t1 == t2;
+    constexpr bool b2 = t1 != t3;
+    constexpr bool b3 = t1.test(0);
+    constexpr bool b4 = t1.test_any(t2);
+    constexpr bool b5 = t1.test_all(t3);
+
+    constexpr auto t4 = (t1 & t2) | (t3 ^ ~empty);
+
+    static_assert(n1 == n2, "");
+    static_assert(b1 && b2 && b3 && b4 && !b5, "");
+    static_assert(t4.test(Wide1::Flag0_bit) && !t4.test(Wide1::Flag100_bit) && t4.test(Wide1::Flag129_bit), "");
+}
+
+TEST_CASE("wide_bit_queries", "[wide]") {
+    const Wide1::type empty;
+    const auto t1 = Wide1::Flag3 | Wide1::Flag64 | Wide1::Flag129;
+
+    REQUIRE(empty.empty() == true);
+    REQUIRE(empty.any() == false);
+    REQUIRE(empty.count() == 0);
+    REQUIRE(empty.lowest_bit() == 130);
+    REQUIRE(empty.highest_bit() == 130);
+
+    REQUIRE(t1.empty() == false);
+    REQUIRE(t1.any() == true);
+    REQUIRE(t1.count() == 3);
+    REQUIRE(t1.lowest_bit() == Wide1::Flag3_bit);
+    REQUIRE(t1.highest_bit() == Wide1::Flag129_bit);
+    REQUIRE((~empty).count() == 130);
+}
+
+TEST_CASE("wide_bit_iteration", "[wide]") {
+    const auto t1 = Wide1::Flag3 | Wide1::Flag64 | Wide1::Flag129;
+
+    std::vector<Wide1::type::bit_type> bits;
+    for (auto bit : t1.bits()) {
+        bits.push_back(bit);
+    }
+    REQUIRE(bits == std::vector<Wide1::type::bit_type> { Wide1::Flag3_bit, Wide1::Flag64_bit, Wide1::Flag129_bit });
+
+    std::vector<Wide1::type> flags;
+    for (auto flag : (t1 | Wide1::Flag127).flags()) {
+        flags.push_back(flag);
+    }
+    REQUIRE(flags == std::vector<Wide1::type> { Wide1::Flag3, Wide1::Flag64, Wide1::Flag127, Wide1::Flag129 });
+
+    std::size_t n = 0;
+    for (auto bit : (~Wide1::type()).bits()) {
+        REQUIRE(bit == n++);
+    }
+    REQUIRE(n == 130);
+    REQUIRE(Wide1::type().bits().begin() == Wide1::type().bits().end());
+}
+
+TEST_CASE("wide_bit_queries_constexpr", "[wide]") {
+    constexpr auto t1 = Wide1::Flag1 | Wide1::Flag100;
+
+    static_assert(t1.count() == 2, "");
+    static_assert(t1.empty() == false, "");
+    static_assert(t1.lowest_bit() == Wide1::Flag1_bit, "");
+    static_assert(t1.highest_bit() == Wide1::Flag100_bit, "");
+    static_assert(*++t1.bits().begin() == Wide1::Flag100_bit, "");
+}
+
+TEST_CASE("wide_many_flags", "[wide]") {
+    static_assert(Wide520::type::bit_count == 520, "");
+    static_assert(Wide520::Flag0_bit == 0 && Wide520::Flag519_bit == 519, "");
+    static_assert(Wide520::Flag300 == Wide520::type::from_bit(300), "");
+
+    REQUIRE(Wide520::type::names[0] == "Flag0");
+    REQUIRE(Wide520::type::names[257] == "Flag257");
+    REQUIRE(Wide520::type::names[519] == "Flag519");
+
+    const auto value = Wide520::Flag15 | Wide520::Flag16 | Wide520::Flag511 | Wide520::Flag519;
+    REQUIRE(value.count() == 4);
+    REQUIRE(value.test(Wide520::Flag511_bit) == true);
+    REQUIRE(value.test(Wide520::Flag512_bit) == false);
+}
+
+TEST_CASE("wide_assembled_flags", "[wide]") {
+    static_assert(Assembled::Low0_bit == 0 && Assembled::Low2_bit == 2 && Assembled::High_bit == 129, "");
+    REQUIRE((Assembled::Low1 | Assembled::High).count() == 2);
+    REQUIRE(Assembled::High == Assembled::type::from_bit(129));
+}